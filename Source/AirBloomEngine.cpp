@@ -0,0 +1,823 @@
+#include "AirBloomEngine.h"
+#include <cmath>
+#include <utility>
+
+namespace
+{
+    // Bloom → shelf / drive mapping
+    constexpr float intensity = 4.0f;  // tweak for more/less presence
+    constexpr float maxShelfDb = 12.0f;
+    constexpr float maxDriveDb = 8.0f;
+
+    const double outputTrim = juce::Decibels::decibelsToGain(-5.0);
+
+    template <typename SampleType>
+    bool isSilent(const juce::dsp::AudioBlock<SampleType>& b) noexcept
+    {
+        const auto n = (int)b.getNumSamples();
+
+        for (size_t ch = 0; ch < b.getNumChannels(); ++ch)
+        {
+            const auto r = juce::FloatVectorOperations::findMinAndMax(b.getChannelPointer(ch), n);
+            if (juce::jmax(-r.getStart(), r.getEnd()) >= (SampleType)FdnReverbBase::silenceThreshold)
+                return false;
+        }
+
+        return true;
+    }
+
+    /* same ramp as AudioBuffer::applyGainRamp */
+    template <typename SampleType>
+    void applyGainRamp(const juce::dsp::AudioBlock<SampleType>& b, SampleType from, SampleType to) noexcept
+    {
+        const auto n = (int)b.getNumSamples();
+
+        if (from == to)
+        {
+            b.multiplyBy(to);
+            return;
+        }
+
+        const SampleType step = (to - from) / (SampleType)n;
+
+        for (size_t ch = 0; ch < b.getNumChannels(); ++ch)
+        {
+            auto* d = b.getChannelPointer(ch);
+            SampleType g = from;
+
+            for (int i = 0; i < n; ++i)
+            {
+                d[i] *= g;
+                g += step;
+            }
+        }
+    }
+
+    /* colour ← mid / side of a stereo block: the copy the colour path
+       needs anyway, with the M/S matrix folded in (decoded again by
+       FusedMixer::bloomPassMidSide) */
+    template <typename SampleType>
+    void encodeMidSide(const juce::dsp::AudioBlock<SampleType>& lr,
+                       const juce::dsp::AudioBlock<SampleType>& ms) noexcept
+    {
+        const auto* l = lr.getChannelPointer(0);
+        const auto* r = lr.getChannelPointer(1);
+        auto* m = ms.getChannelPointer(0);
+        auto* s = ms.getChannelPointer(1);
+
+        for (size_t i = 0; i < lr.getNumSamples(); ++i)
+        {
+            const SampleType a = l[i], b = r[i];
+            m[i] = (a + b) * SampleType(0.5);
+            s[i] = (a - b) * SampleType(0.5);
+        }
+    }
+
+    /* the first numCh × numSmp of a scratch buffer */
+    template <typename SampleType>
+    juce::dsp::AudioBlock<SampleType> chunkOf(juce::AudioBuffer<SampleType>& b, size_t numCh, size_t numSmp) noexcept
+    {
+        return juce::dsp::AudioBlock<SampleType>(b).getSubsetChannelBlock(0, numCh).getSubBlock(0, numSmp);
+    }
+
+    int toChoice(float v) noexcept { return static_cast<int>(v + 0.5f); }
+}
+
+//==============================================================================
+bool AirBloomEngineBase::Parameters::set(const juce::String& id, float v)
+{
+    if      (id == "bloom")         bloom = v;
+    else if (id == "bloomMode")     bloomMode = toChoice(v);
+    else if (id == "bloomSide")     bloomSide = v;
+    else if (id == "reverbWet")     reverbWet = v;
+    else if (id == "inputGain")     inputGainDb = v;
+    else if (id == "outputGain")    outputGainDb = v;
+    else if (id == "bypass")        bypass = v > 0.5f;
+    else if (id == "lowCut")        lowCut = v > 0.5f;
+    else if (id == "oversample")    oversample = toChoice(v);
+    else if (id == "osFilter")      osFilter = toChoice(v);
+    else if (id == "reverbDecay")   reverbDecay = v;
+    else if (id == "reverbSize")    reverbSize = v;
+    else if (id == "reverbDamping") reverbDamping = v;
+    else if (id == "reverbOrder")   reverbOrder = toChoice(v);
+    else                            return false;
+
+    return true;
+}
+
+OversamplingMode AirBloomEngineBase::Parameters::getOversamplingMode(bool isNonRealtime) const noexcept
+{
+    OversamplingMode m;
+    m.factorChoice = juce::jlimit(0, OversamplingMode::numFactors - 1, oversample);
+    m.filter = (OversamplingMode::Filter)juce::jlimit(0, OversamplingMode::numFilters - 1, osFilter);
+    return m.resolvedFor(isNonRealtime);
+}
+
+FdnReverbBase::Parameters AirBloomEngineBase::Parameters::getReverbParameters() const noexcept
+{
+    FdnReverbBase::Parameters p;
+    p.order = 4 << juce::jlimit(0, 2, reverbOrder);
+    p.decaySeconds = reverbDecay;
+    p.size = reverbSize;
+    p.damping = reverbDamping;
+    return p;
+}
+
+double AirBloomEngineBase::getTailSeconds(const Parameters& p) noexcept
+{
+    return FdnReverbBase::getTailSeconds(p.getReverbParameters());
+}
+
+float AirBloomEngineBase::getShelfBoostDb(float bloom) noexcept
+{
+    return juce::jlimit(0.0f, 1.0f, bloom) * maxShelfDb * intensity;
+}
+
+void AirBloomEngineBase::getShelfResponse(double shelfRate, float bloom, const double* frequencies,
+                                          double* magnitudes, size_t num)
+{
+    ShelfCoefficientTable::makeShelf(shelfRate, getShelfBoostDb(bloom))
+        ->getMagnitudeForFrequencyArray(frequencies, magnitudes, num, shelfRate);
+}
+
+//==============================================================================
+template <typename SampleType>
+AirBloomEngine<SampleType>::~AirBloomEngine()
+{
+    delete pendingPath.exchange(nullptr);
+    delete retiredPath.exchange(nullptr);
+}
+
+template <typename SampleType>
+void AirBloomEngine<SampleType>::setChunkSize(int maxSamples) noexcept
+{
+    requestedChunk = maxSamples > 0 ? maxSamples : defaultChunkSize;
+}
+
+template <typename SampleType>
+void AirBloomEngine<SampleType>::setNumInputChannels(int numInputs) noexcept
+{
+    requestedInputs = numInputs;
+}
+
+template <typename SampleType>
+void AirBloomEngine<SampleType>::prepare(const juce::dsp::ProcessSpec& hostSpec, OversamplingMode mode,
+                                         const Parameters& initial)
+{
+    // everything inside runs on chunks, never on the host's whole block
+    chunkSize = juce::jmax(1, juce::jmin((int)hostSpec.maximumBlockSize, requestedChunk));
+    jassert((int)hostSpec.numChannels <= maxChannels);
+    numChannels = juce::jmin((int)hostSpec.numChannels, maxChannels);
+    monoToStereo = requestedInputs == 1 && numChannels == 2;
+
+    // the reverb's output is the only thing that needs both channels of
+    // a mono → stereo layout
+    const int numCh = monoToStereo ? 1 : numChannels;
+
+    const juce::dsp::ProcessSpec spec{ hostSpec.sampleRate, (juce::uint32)chunkSize,
+                                       (juce::uint32)numCh };
+    const juce::dsp::ProcessSpec reverbSpec{ spec.sampleRate, spec.maximumBlockSize,
+                                             (juce::uint32)numChannels };
+
+    const double sampleRate = spec.sampleRate;
+    const int samplesPerBlock = chunkSize;
+
+    params = initial;
+    latestBloom = initial.bloom;
+    prevInGain = 1;
+    prevOutGain = 1;
+
+    // 1) colour stage – only the path for the selected factor is built
+    {
+        const juce::ScopedLock sl(pathLock);
+        preparedSpec = spec;
+
+        delete pendingPath.exchange(nullptr);
+        delete retiredPath.exchange(nullptr);
+        fadingPath.reset();
+
+        requestedMode = mode;
+        activePath = makeColourPath(requestedMode);
+        latency = activePath->getLatencySamples();
+        isPathPrepared = true;
+    }
+
+    fadeLength = juce::roundToInt(sampleRate * 0.02);   // 20 ms path crossfade
+    fadePos = 0;
+    pathMidSide = params.bloomMode == 1 && numCh == 2;
+    modeFade = false;
+
+    // 2) init HPF + reverb
+    reverbHpf.prepare(spec);
+    reverbHpf.setCoefficients(*juce::dsp::IIR::Coefficients<SampleType>::makeHighPass(
+        sampleRate, SampleType(800), SampleType(0.7071)));
+
+    // parameters first, so prepare() starts the network on them rather
+    // than ramping over from the defaults
+    for (auto& r : reverbs)
+    {
+        r.setParameters(params.getReverbParameters());
+        r.prepare(reverbSpec);
+    }
+
+    reverbIndex = 0;
+
+    lowCutFilter.prepare(spec);
+    lowCutFilter.setCoefficients(*juce::dsp::IIR::Coefficients<SampleType>::makeHighPass
+    (sampleRate, SampleType(100), SampleType(0.7071)));   // 100 Hz, Q ≈ 0.7
+
+    constexpr double smoothTimeSec = 0.05;          // 50 ms ramp
+
+    bloomSm.prepare(sampleRate, smoothTimeSec, samplesPerBlock);
+    wetSm.prepare(sampleRate, smoothTimeSec, samplesPerBlock);
+    sideSm.prepare(sampleRate, smoothTimeSec, samplesPerBlock);
+    lowCutSm.prepare(sampleRate, smoothTimeSec, samplesPerBlock);
+    activeSm.prepare(sampleRate, smoothTimeSec, samplesPerBlock);
+    mixer.prepare(samplesPerBlock);
+
+    /* start at current param values so there’s no jump on first block */
+    bloomSm.setCurrentAndTargetValue(params.bloom);
+    wetSm.setCurrentAndTargetValue(params.reverbWet);
+    sideSm.setCurrentAndTargetValue(params.bloomSide);
+    lowCutSm.setCurrentAndTargetValue(params.lowCut && !params.bypass ? 1 : 0);
+    activeSm.setCurrentAndTargetValue(params.bypass ? 0 : 1);
+
+    // 3) allocate temp buffers
+    colorBuffer.setSize(numCh, samplesPerBlock, false, true, true);
+    reverbBuffer.setSize(numChannels, samplesPerBlock, false, true, true);
+    fadeColour.setSize(numCh, samplesPerBlock, false, true, true);
+    fadeDry.setSize(numCh, samplesPerBlock, false, true, true);
+    tailBuffer.setSize(numChannels, samplesPerBlock, false, true, true);
+}
+
+template <typename SampleType>
+void AirBloomEngine<SampleType>::release()
+{
+    // audio has stopped, so the oversampler memory can go too
+    const juce::ScopedLock sl(pathLock);
+    delete pendingPath.exchange(nullptr);
+    delete retiredPath.exchange(nullptr);
+    fadingPath.reset();
+    activePath.reset();
+    isPathPrepared = false;
+    chunkSize = 0;
+}
+
+template <typename SampleType>
+void AirBloomEngine<SampleType>::setParameters(const Parameters& p) noexcept
+{
+    params = p;
+    latestBloom = p.bloom;
+}
+
+//==============================================================================
+template <typename SampleType>
+std::unique_ptr<ColourPath<SampleType>> AirBloomEngine<SampleType>::makeColourPath(OversamplingMode mode) const
+{
+    auto make = [&]
+    {
+        auto p = std::make_unique<Path>(mode);
+        p->prepare(preparedSpec, maxShelfDb * intensity, maxDriveDb * intensity,
+                   latestBloom.load());
+        return p;
+    };
+
+    // a stereo pair can switch Bloom mode, which crossfades to the twin
+    auto path = make();
+    if (preparedSpec.numChannels == 2)
+        path->setTwin(make());
+
+    return path;
+}
+
+// off the audio thread: build the path for a new oversampling mode
+// (factor, filter, or the host switching to/from offline rendering), and
+// delete the one the audio thread has finished crossfading out
+template <typename SampleType>
+bool AirBloomEngine<SampleType>::updateColourPath(OversamplingMode mode)
+{
+    const juce::ScopedLock sl(pathLock);
+
+    delete retiredPath.exchange(nullptr);
+
+    if (!isPathPrepared || mode == requestedMode)
+        return false;
+
+    // report the latency straight away – the crossfade follows within a block
+    auto path = makeColourPath(mode);
+    latency = path->getLatencySamples();
+    requestedMode = mode;
+
+    // replaces any path the audio thread hasn't picked up yet
+    delete pendingPath.exchange(path.release());
+    return true;
+}
+
+//==============================================================================
+template <typename SampleType>
+void AirBloomEngine<SampleType>::process(juce::AudioBuffer<SampleType>& buffer) noexcept
+{
+    process(Block(buffer));
+}
+
+template <typename SampleType>
+void AirBloomEngine<SampleType>::process(const Block& block) noexcept
+{
+    if (chunkSize <= 0)                  // released / never prepared
+        return;
+
+    // more channels than prepared would need bigger scratch – leave them
+    jassert((int)block.getNumChannels() <= numChannels);
+    const auto io = block.getSubsetChannelBlock(0, (size_t)juce::jmin((int)block.getNumChannels(),
+                                                                      numChannels));
+    const auto numSmp = io.getNumSamples();
+
+    for (size_t pos = 0; pos < numSmp; pos += (size_t)chunkSize)
+        processChunk(io.getSubBlock(pos, juce::jmin((size_t)chunkSize, numSmp - pos)));
+}
+
+template <typename SampleType>
+void AirBloomEngine<SampleType>::processChunk(Block out) noexcept
+{
+    // mono → stereo: everything up to the reverb runs on channel 0 alone,
+    // copied to channel 1 once it's mixed; the host's channel 1 is never read
+    const bool split = monoToStereo && out.getNumChannels() == 2;
+    auto io = split ? out.getSingleChannelBlock(0) : out;
+
+    const auto numCh = io.getNumChannels();
+    const auto numSmp = io.getNumSamples();
+    const int  n = (int)numSmp;
+
+    auto colour = chunkOf(colorBuffer, numCh, numSmp);
+    auto send = chunkOf(reverbBuffer, numCh, numSmp);
+    auto wet = chunkOf(reverbBuffer, out.getNumChannels(), numSmp);   // send + the reverb's R
+
+    // 1) read UI
+    bloomSm.setTargetValue((SampleType)params.bloom);
+    wetSm.setTargetValue((SampleType)params.reverbWet);
+    sideSm.setTargetValue((SampleType)params.bloomSide);
+    lowCutSm.setTargetValue(params.lowCut && !params.bypass ? 1 : 0);
+    activeSm.setTargetValue(params.bypass ? 0 : 1);
+    const float bloom = params.bloom;
+    constexpr bool atmos = true;       // always ON now
+    const float wetMix = params.reverbWet;
+    const auto inG = juce::Decibels::decibelsToGain((SampleType)params.inputGainDb);
+    const auto outG = juce::Decibels::decibelsToGain((SampleType)params.outputGainDb);
+    const bool wantMidSide = params.bloomMode == 1 && numCh == 2;
+
+    switchReverbOrder();
+    activeSm.process(n);
+
+    AIRBLOOM_PROFILE_LAPS(profiler);
+
+    /* ---------- TRUE-BYPASS EARLY-OUT -------------------- */
+    // once bypass has faded all the way in (see bypassFade below)
+    if (!activeSm.isRamping() && activeSm.getCurrentValue() <= 0)
+    {
+        prevInGain = 1;      // where the fade back out starts
+        prevOutGain = outG * (SampleType)outputTrim;
+        bloomSm.setCurrentAndTargetValue((SampleType)params.bloom);
+        wetSm.setCurrentAndTargetValue((SampleType)params.reverbWet);
+        sideSm.setCurrentAndTargetValue((SampleType)params.bloomSide);
+        lowCutSm.setCurrentAndTargetValue(0);
+        lowCutFilter.reset();
+        if (activePath != nullptr)  activePath->snapBloom(params.bloom);
+        if (fadingPath != nullptr)  fadingPath->snapBloom(params.bloom);
+
+        // nothing of the colour path is heard, so there's nothing to fade:
+        // finish a crossfade, or take a new path or Bloom mode, straight
+        // away (one path per block – they share the retired slot)
+        if (fadingPath != nullptr && modeFade)
+        {
+            activePath->setTwin(std::move(fadingPath));
+            modeFade = false;
+        }
+
+        if (retiredPath.load() == nullptr)
+        {
+            if (fadingPath != nullptr)
+            {
+                retiredPath.store(fadingPath.release());
+            }
+            else if (auto* next = pendingPath.exchange(nullptr))
+            {
+                retiredPath.store(activePath.release());
+                activePath.reset(next);
+            }
+        }
+
+        pathMidSide = wantMidSide;
+
+        // the host still compensates for the reported latency, so the
+        // bypassed signal has to arrive just as late as the processed one
+        if (activePath != nullptr)  activePath->delayDry(io);
+
+        if (split)
+            out.getSingleChannelBlock(1).copyFrom(io);
+
+        ringOutReverb(out, outG);
+        AIRBLOOM_PROFILE_LAP(reverb);
+        return;
+    }
+    /* ----------------------------------------------------- */
+
+    if (activePath == nullptr)
+        return;
+
+    // Bypass fading in or out: input gain, low cut, Bloom and output gain
+    // all head for unity with activeSm, so at 0 the chain is the delayed
+    // input plus the reverb tail – exactly what the early-out plays
+    const bool bypassFade = activeSm.isRamping();
+    const auto inGain = bypassFade ? 1 + (inG - 1) * activeSm.getCurrentValue() : inG;
+
+    applyGainRamp(io, prevInGain, inGain);
+    prevInGain = inGain;
+    AIRBLOOM_PROFILE_LAP(inputGain);
+
+    /* ---------- OPTIONAL MAIN-PATH HPF ------------------- */
+    // switching it crossfades filtered and unfiltered over the smoothing
+    // time (colour is free scratch until step 3)
+    lowCutSm.process(n);
+
+    if (lowCutSm.isRamping())
+    {
+        colour.copyFrom(io);
+        lowCutFilter.process(juce::dsp::ProcessContextReplacing<SampleType>(colour));
+
+        for (size_t ch = 0; ch < numCh; ++ch)
+            lowCutSm.mixInto(io.getChannelPointer(ch), colour.getChannelPointer(ch), n);
+
+        AIRBLOOM_PROFILE_LAP(lowCut);
+    }
+    else if (lowCutSm.getCurrentValue() > 0)
+    {
+        lowCutFilter.process(juce::dsp::ProcessContextReplacing<SampleType>(io));
+        AIRBLOOM_PROFILE_LAP(lowCut);
+    }
+    else
+    {
+        lowCutFilter.reset();           // fade the next switch-on in from rest
+    }
+    /* ----------------------------------------------------- */
+
+    // 2) pick up a newly built colour path (oversampling change) and start
+    //    crossfading to it; never while the previous swap is still settling
+    if (fadingPath == nullptr && retiredPath.load() == nullptr)
+    {
+        if (auto* next = pendingPath.exchange(nullptr))
+        {
+            fadingPath = std::move(activePath);
+            activePath.reset(next);
+            fadePos = 0;
+        }
+    }
+
+    //    a new Bloom mode starts the path's twin on it from rest, and the
+    //    two mixes crossfade; it too waits for any other swap to finish
+    if (wantMidSide != pathMidSide && fadingPath == nullptr)
+    {
+        if (auto twin = activePath->takeTwin())
+        {
+            twin->reset();
+            twin->snapBloom(bloom);
+            fadingPath = std::move(activePath);
+            activePath = std::move(twin);
+            modeFade = true;
+            fadePos = 0;
+        }
+
+        pathMidSide = wantMidSide;
+    }
+
+    activePath->setBloomTarget(bloom);
+    if (fadingPath != nullptr)
+        fadingPath->setBloomTarget(bloom);
+
+    // 3) run colour stage on a temp copy (oversampled if asked for); the
+    //    path also delays `io` by its latency so dry and colour line up.
+    //    Mid / side mode colours M and S instead of L and R
+    const bool modesFading = modeFade;
+
+    if (pathMidSide)
+        encodeMidSide(io, colour);
+    else
+        colour.copyFrom(io);
+
+    if (modesFading)
+        processModes(io, colour);
+    else if (fadingPath != nullptr)
+        crossfadePaths(io, colour);
+    else
+        activePath->process(colour, io);
+
+    clipPeak = juce::jmax(clipPeak, activePath->takeClipPeak());
+    if (fadingPath != nullptr)        // null again once its crossfade is done
+        clipPeak = juce::jmax(clipPeak, fadingPath->takeClipPeak());
+
+    AIRBLOOM_PROFILE_LAP(colour);
+
+    // 4) Bloom crossfade, reverb send and – if the reverb is idle – the
+    //    output gain, all in one sweep per channel (see FusedMixer.h)
+    bloomSm.process(n);
+    wetSm.process(n);
+    sideSm.process(n);
+
+    // keep the reverb running while the wet ramp fades out, so turning it
+    // down to 0 doesn't click
+    const bool  wetOn = atmos && (wetMix > 0.0f || wetSm.isRamping());
+
+    // once its tail has died away the reverb sleeps; while the send stays
+    // silent skip it and fold the (1 − wet) dry level into the gain instead
+    const bool  runReverb = wetOn && (!reverb().isAsleep()
+                                      || !outgoingReverb().isAsleep()
+                                      || !isSilent(io)
+                                      || !isSilent(colour));
+
+    const auto  newOutGain = outG * (SampleType)outputTrim;
+    const auto  outRamp = mixer.makeGainRamp(prevOutGain, newOutGain, n);
+    prevOutGain = newOutGain;
+
+    // while bypass fades, the dry level is set after the reverb instead
+    // (bypassFadePass), so the mix itself stays at unity
+    const auto  dryGain = (runReverb || bypassFade) ? Mixer::constant(1)
+                        : wetOn ? mixer.makeDryGain(Mixer::rampOf(wetSm), outRamp, n)
+                                : outRamp;
+
+    const auto  bloomRamp = bypassFade ? mixer.makeProduct(Mixer::rampOf(bloomSm),
+                                                           Mixer::rampOf(activeSm), n)
+                                       : Mixer::rampOf(bloomSm);
+
+    if (modesFading)
+    {
+        // the send is the mix at unity gain, so it's copied after the blend
+        crossfadeModes(io, colour, bloomRamp, dryGain);
+
+        if (runReverb)
+            send.copyFrom(io);
+    }
+    else
+    {
+        bloomMix(io, colour, pathMidSide, runReverb ? &send : nullptr, bloomRamp, dryGain);
+    }
+
+    // bypass cuts the send as it fades in
+    if (runReverb && bypassFade)
+        for (size_t ch = 0; ch < numCh; ++ch)
+            juce::FloatVectorOperations::multiply(send.getChannelPointer(ch), activeSm.getRamp(), n);
+
+    if (split)
+        out.getSingleChannelBlock(1).copyFrom(io);
+
+    AIRBLOOM_PROFILE_LAP(mix);
+
+    // 5) reverb that coloured signal, then crossfade it in with the gain;
+    //    a mono send comes back as an L/R tail
+    if (runReverb)
+    {
+        reverbHpf.process(juce::dsp::ProcessContextReplacing<SampleType>(send));
+        reverb().setParameters(getRunningReverbParameters());
+
+        if (split)
+            reverb().process(juce::dsp::ProcessContextNonReplacing<SampleType>(send, wet));
+        else
+            reverb().process(juce::dsp::ProcessContextReplacing<SampleType>(send));
+
+        addOutgoingTail(wet);
+
+        AIRBLOOM_PROFILE_LAP(reverb);
+
+        for (size_t ch = 0; ch < out.getNumChannels(); ++ch)
+        {
+            if (bypassFade)
+                Mixer::bypassFadePass(out.getChannelPointer(ch), wet.getChannelPointer(ch),
+                                      Mixer::rampOf(activeSm), Mixer::rampOf(wetSm), outRamp, n);
+            else
+                Mixer::wetPass(out.getChannelPointer(ch),
+                               wet.getChannelPointer(ch),
+                               Mixer::rampOf(wetSm), outRamp, n);
+        }
+
+        AIRBLOOM_PROFILE_LAP(mix);           // the wet half of it
+    }
+    else if (bypassFade)
+    {
+        for (size_t ch = 0; ch < out.getNumChannels(); ++ch)
+            Mixer::bypassFadePass(out.getChannelPointer(ch), nullptr, Mixer::rampOf(activeSm),
+                                  wetOn ? Mixer::rampOf(wetSm) : Mixer::constant(0), outRamp, n);
+
+        AIRBLOOM_PROFILE_LAP(mix);
+    }
+}
+
+// the Bloom mix for one colour path's output: per channel, or decoding
+// a mid / side pair back to L/R; send is null while the reverb is idle
+template <typename SampleType>
+void AirBloomEngine<SampleType>::bloomMix(Block& dry, Block& colour, bool midSide, Block* send,
+                                          typename Mixer::Ramp bloom,
+                                          typename Mixer::Ramp dryGain) noexcept
+{
+    const int n = (int)dry.getNumSamples();
+
+    if (midSide)
+        Mixer::bloomPassMidSide(dry.getChannelPointer(0), dry.getChannelPointer(1),
+                                colour.getChannelPointer(0), colour.getChannelPointer(1),
+                                send != nullptr ? send->getChannelPointer(0) : nullptr,
+                                send != nullptr ? send->getChannelPointer(1) : nullptr,
+                                bloom,
+                                Mixer::rampOf(sideSm),
+                                dryGain,
+                                n);
+    else
+        for (size_t ch = 0; ch < dry.getNumChannels(); ++ch)
+            Mixer::bloomPass(dry.getChannelPointer(ch),
+                             colour.getChannelPointer(ch),
+                             send != nullptr ? send->getChannelPointer(ch) : nullptr,
+                             bloom,
+                             dryGain,
+                             n);
+}
+
+template <typename SampleType>
+float AirBloomEngine<SampleType>::takeClipGainReductionDb() noexcept
+{
+    const auto peak = std::exchange(clipPeak, SampleType(0));
+
+    if (peak <= SampleType(1.0e-5))
+        return 0.0f;
+
+    const auto out = std::abs(SoftClipper::processSample(peak));
+    return juce::Decibels::gainToDecibels((float)(out / (peak * (SampleType)SoftClipper::drive)));
+}
+
+// Bypass cuts the send, not the tail: the reverb is fed silence and its
+// output laid over the untouched input until it falls asleep.
+template <typename SampleType>
+void AirBloomEngine<SampleType>::ringOutReverb(Block& io, SampleType outGain) noexcept
+{
+    const auto wet = (SampleType)params.reverbWet;
+
+    if (wet <= 0 || (reverb().isAsleep() && outgoingReverb().isAsleep()))
+        return;
+
+    auto send = chunkOf(reverbBuffer, io.getNumChannels(), io.getNumSamples());
+    send.clear();
+
+    reverb().setParameters(getRunningReverbParameters());
+    reverb().process(juce::dsp::ProcessContextReplacing<SampleType>(send));
+    addOutgoingTail(send);
+
+    io.addProductOf(send, wet * outGain * (SampleType)outputTrim);
+}
+
+// A new reverb order starts on the other network, from silence, and the
+// one running now is left to ring out, fed nothing. Changing the order of
+// a network clears it, so a second change while the last one's tail is
+// still ringing waits for that tail to fall asleep.
+template <typename SampleType>
+void AirBloomEngine<SampleType>::switchReverbOrder() noexcept
+{
+    const auto p = params.getReverbParameters();
+
+    if (p.order != reverb().getParameters().order && outgoingReverb().isAsleep())
+    {
+        reverbIndex ^= 1;
+        reverb().setParameters(p);
+    }
+}
+
+// the parameters, with the order the running network has (a new one may
+// be waiting, see switchReverbOrder())
+template <typename SampleType>
+FdnReverbBase::Parameters AirBloomEngine<SampleType>::getRunningReverbParameters() noexcept
+{
+    auto p = params.getReverbParameters();
+    p.order = reverb().getParameters().order;
+    return p;
+}
+
+// the outgoing network's tail, added to `wet` until it falls asleep; it
+// keeps the parameters it had when the order changed
+template <typename SampleType>
+void AirBloomEngine<SampleType>::addOutgoingTail(Block& wet) noexcept
+{
+    auto& old = outgoingReverb();
+
+    if (old.isAsleep())
+        return;
+
+    auto tail = chunkOf(tailBuffer, wet.getNumChannels(), wet.getNumSamples());
+    tail.clear();
+    old.process(juce::dsp::ProcessContextReplacing<SampleType>(tail));
+    wet.add(tail);
+}
+
+//==============================================================================
+// Runs the incoming and the outgoing colour path side by side and fades
+// from one to the other over fadeLength samples. Both the colour and the
+// latency-compensated dry signal are faded, so the Bloom mix stays valid.
+template <typename SampleType>
+void AirBloomEngine<SampleType>::crossfadePaths(Block& dry, Block& colour) noexcept
+{
+    const auto numCh = dry.getNumChannels();
+    const auto numSmp = dry.getNumSamples();
+
+    auto oldColour = chunkOf(fadeColour, numCh, numSmp);
+    auto oldDry = chunkOf(fadeDry, numCh, numSmp);
+    oldColour.copyFrom(colour);
+    oldDry.copyFrom(dry);
+
+    activePath->process(colour, dry);
+    fadingPath->process(oldColour, oldDry);
+
+    const SampleType step = SampleType(1) / (SampleType)juce::jmax(1, fadeLength);
+
+    for (size_t ch = 0; ch < numCh; ++ch)
+    {
+        auto* col = colour.getChannelPointer(ch);
+        auto* d = dry.getChannelPointer(ch);
+        auto* oldCol = oldColour.getChannelPointer(ch);
+        auto* oldD = oldDry.getChannelPointer(ch);
+
+        for (int i = 0; i < (int)numSmp; ++i)
+        {
+            const SampleType g = juce::jmin(SampleType(1), (SampleType)(fadePos + i) * step);
+            col[i] = oldCol[i] + g * (col[i] - oldCol[i]);
+            d[i] = oldD[i] + g * (d[i] - oldD[i]);
+        }
+    }
+
+    fadePos += (int)numSmp;
+
+    if (fadePos >= fadeLength)
+        retiredPath.store(fadingPath.release());   // deleted in updateColourPath()
+}
+
+//==============================================================================
+// A Bloom mode change: the outgoing path carries on in the old mode with
+// the dry line it has been running, the twin starts in the new one. Both
+// mixes use the outgoing dry line; the twin's is fed too, and the fade
+// lasts long enough to fill it before the twin takes over.
+template <typename SampleType>
+void AirBloomEngine<SampleType>::processModes(Block& dry, Block& colour) noexcept
+{
+    const auto numCh = dry.getNumChannels();
+    const auto numSmp = dry.getNumSamples();
+
+    auto oldColour = chunkOf(fadeColour, numCh, numSmp);
+    auto oldDry = chunkOf(fadeDry, numCh, numSmp);
+
+    if (pathMidSide)
+        oldColour.copyFrom(dry);
+    else
+        encodeMidSide(dry, oldColour);
+
+    oldDry.copyFrom(dry);
+
+    activePath->process(colour, dry);
+    fadingPath->process(oldColour, oldDry);
+    dry.copyFrom(oldDry);
+}
+
+// ...then mixes each path in its own mode, and fades from the old mix to
+// the new one; the twin that's faded out waits on the new path for the
+// next change
+template <typename SampleType>
+void AirBloomEngine<SampleType>::crossfadeModes(Block& dry, Block& colour,
+                                                typename Mixer::Ramp bloom,
+                                                typename Mixer::Ramp dryGain) noexcept
+{
+    const auto numCh = dry.getNumChannels();
+    const auto numSmp = dry.getNumSamples();
+
+    auto oldColour = chunkOf(fadeColour, numCh, numSmp);
+    auto oldDry = chunkOf(fadeDry, numCh, numSmp);
+
+    bloomMix(oldDry, oldColour, !pathMidSide, nullptr, bloom, dryGain);
+    bloomMix(dry, colour, pathMidSide, nullptr, bloom, dryGain);
+
+    const int length = juce::jmax(fadeLength, activePath->getLatencySamples() + 1);
+    const SampleType step = SampleType(1) / (SampleType)length;
+
+    for (size_t ch = 0; ch < numCh; ++ch)
+    {
+        auto* d = dry.getChannelPointer(ch);
+        auto* oldD = oldDry.getChannelPointer(ch);
+
+        for (int i = 0; i < (int)numSmp; ++i)
+        {
+            const SampleType g = juce::jmin(SampleType(1), (SampleType)(fadePos + i) * step);
+            d[i] = oldD[i] + g * (d[i] - oldD[i]);
+        }
+    }
+
+    fadePos += (int)numSmp;
+
+    if (fadePos >= length)
+    {
+        activePath->setTwin(std::move(fadingPath));
+        modeFade = false;
+    }
+}
+
+template class AirBloomEngine<float>;
+template class AirBloomEngine<double>;
@@ -0,0 +1,208 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include "ColourPath.h"
+#include "FusedMixer.h"
+#include "FdnReverb.h"
+#include "MultichannelBiquad.h"
+#include "StageProfiler.h"
+
+/*  The whole AirBloom chain – input gain, low cut, colour path, Bloom mix,
+    reverb send, output gain – with no AudioProcessor, editor or parameter
+    tree attached. The plug-in wraps it; so does the headless
+    AirBloomRender tool.
+
+    Threads:
+      prepare() / release()     audio stopped
+      setParameters(), process()  audio thread, once per block
+      updateColourPath()        any other thread (the plug-in's timer);
+                                builds the path for a new oversampling
+                                mode, which process() then crossfades in
+
+    Whatever size block the host sends, process() works through it in
+    chunks of at most getChunkSize() samples, so every internal buffer is
+    allocated once in prepare() and never resized. The chunk size is
+    capped by the prepared block size and by setChunkSize() – smaller
+    chunks keep the oversampled data in cache.
+
+    Up to maxChannels channels (a 9.1.6 bed). The filters run all channels
+    side by side in SIMD lanes (MultichannelBiquad), and on more than two
+    channels the reverb gives each one its own decorrelated tail.
+
+    Mono tracks run one channel through everything. Mono in, stereo out
+    (setNumInputChannels(1) with a two-channel spec) also runs the
+    filters and colour path on the one channel, feeds the reverb the
+    mono send and only splits into L/R for the reverb's tail.
+
+    In mid / side Bloom mode a stereo pair is encoded to M/S as it's
+    copied into the colour buffer, and decoded again inside the Bloom
+    mix, so the mode costs no extra pass over the audio.
+
+    None of the switches jump. Bypass fades the processing to unity (the
+    reverb tail rings on either way); a Bloom mode change runs the colour
+    path's twin in the new mode from rest and crossfades the two decoded
+    mixes; a new reverb order starts on a second network while the old
+    one rings out, fed nothing, until it falls asleep.
+
+    The chain is one template, instantiated for float and double (see the
+    end of AirBloomEngine.cpp); AirBloomEngineBase holds what doesn't
+    depend on the sample type.                                          */
+class AirBloomEngineBase
+{
+public:
+    /* plain values, same units and IDs as the plug-in parameters */
+    struct Parameters
+    {
+        float bloom = 0.0f;
+        int   bloomMode = 0;            // 0 stereo, 1 mid / side (stereo buses only)
+        float bloomSide = 1.0f;         // mid / side: 0 mid only, 0.5 both, 1 side only
+        float reverbWet = 0.3f;
+        float inputGainDb = 0.0f;
+        float outputGainDb = 0.0f;
+        bool  bypass = false;
+        bool  lowCut = false;
+        int   oversample = 0;           // OversamplingMode factor choice
+        int   osFilter = 0;             // OversamplingMode::Filter
+        float reverbDecay = 1.5f;       // RT60, seconds
+        float reverbSize = 0.8f;
+        float reverbDamping = 0.2f;
+        int   reverbOrder = 1;          // 0 / 1 / 2  →  4 / 8 / 16 lines
+
+        /* by parameter ID, as stored in the plug-in state and .abp presets;
+           false if the ID isn't one of ours */
+        bool set(const juce::String& paramID, float value);
+
+        OversamplingMode getOversamplingMode(bool isNonRealtime) const noexcept;
+        FdnReverbBase::Parameters getReverbParameters() const noexcept;
+    };
+
+    static constexpr int defaultChunkSize = 512;
+    static constexpr int maxChannels = MultichannelBiquad<float>::maxChannels;
+
+    static double getTailSeconds(const Parameters& p) noexcept;
+
+    /* the Bloom shelf: its boost at `bloom`, and its magnitude response
+       running at shelfRate (host rate × oversampling factor) – for
+       drawing the curve, not for the audio thread */
+    static float getShelfBoostDb(float bloom) noexcept;
+    static void  getShelfResponse(double shelfRate, float bloom, const double* frequencies,
+                                  double* magnitudes, size_t num);
+};
+
+template <typename SampleType>
+class AirBloomEngine : public AirBloomEngineBase
+{
+public:
+    AirBloomEngine() = default;
+    ~AirBloomEngine();
+
+    /* call before prepare(); <= 0 → defaultChunkSize */
+    void setChunkSize(int maxSamples) noexcept;
+    int  getChunkSize() const noexcept { return chunkSize; }
+
+    /* call before prepare(); 1 with a two-channel spec is mono in, stereo
+       out (channel 1 of the block is only written); <= 0 → as many inputs
+       as channels */
+    void setNumInputChannels(int numInputs) noexcept;
+    bool isMonoToStereo() const noexcept { return monoToStereo; }
+
+    /* call while audio is stopped; where process() records its per-stage
+       timings, if built with AIRBLOOM_PROFILE_STAGES (nullptr → nowhere) */
+    void setProfiler(StageProfiler* p) noexcept { profiler = p; }
+
+    void prepare(const juce::dsp::ProcessSpec& spec, OversamplingMode mode,
+                 const Parameters& initial);
+    void release();
+
+    void setParameters(const Parameters& p) noexcept;
+    const Parameters& getParameters() const noexcept { return params; }
+
+    /* any number of samples; channels past the prepared count are left alone */
+    void process(juce::AudioBuffer<SampleType>& buffer) noexcept;
+    void process(const juce::dsp::AudioBlock<SampleType>& block) noexcept;
+
+    /* true if a new path was built – the latency may have changed */
+    bool updateColourPath(OversamplingMode mode);
+
+    /* audio thread, after process(): the Bloom soft clip's gain reduction
+       at its loudest since the last call, in dB (≤ 0, against the clip's
+       small-signal gain) */
+    float takeClipGainReductionDb() noexcept;
+
+    /* latency of the newest path asked for (what the host should hear) */
+    int getLatencySamples() const noexcept { return latency.load(); }
+
+private:
+    using HPF = MultichannelBiquad<SampleType>;
+    using Block = juce::dsp::AudioBlock<SampleType>;
+    using Path = ColourPath<SampleType>;
+    using Mixer = FusedMixer<SampleType>;
+
+    Parameters params;
+
+    HPF                   reverbHpf;     // 800 Hz ahead of the reverb
+    std::array<FdnReverb<SampleType>, 2> reverbs;   // running, and the last order ringing out
+    int                   reverbIndex = 0;
+    HPF                   lowCutFilter;  // 100 Hz, main signal
+
+    FdnReverb<SampleType>& reverb() noexcept          { return reverbs[(size_t)reverbIndex]; }
+    FdnReverb<SampleType>& outgoingReverb() noexcept  { return reverbs[(size_t)(reverbIndex ^ 1)]; }
+
+    // — scratch, chunkSize long, allocated in prepare() only; one channel
+    //   short of the reverb's in mono → stereo —
+    juce::AudioBuffer<SampleType> colorBuffer, reverbBuffer;
+    juce::AudioBuffer<SampleType> fadeColour, fadeDry;   // outgoing path while switching
+    juce::AudioBuffer<SampleType> tailBuffer;            // outgoing reverb's tail
+
+    int requestedChunk = defaultChunkSize;
+    int requestedInputs = 0;
+    int chunkSize = 0;                               // 0 until prepared
+    int numChannels = 0;
+    bool monoToStereo = false;                       // channel 0 in, 0 and 1 out
+    StageProfiler* profiler = nullptr;
+
+    /* ── colour stage (shelf + drive + clip, oversampled) ─────── */
+    // Only the path for the selected mode exists. A mode change is
+    // built off the audio thread (updateColourPath), handed over through
+    // pendingPath, crossfaded in on the audio thread, and the old path
+    // comes back through retiredPath to be deleted off the audio thread.
+    std::unique_ptr<Path> activePath;                // audio thread
+    std::unique_ptr<Path> fadingPath;                // audio thread, outgoing
+    std::atomic<Path*>    pendingPath{ nullptr };
+    std::atomic<Path*>    retiredPath{ nullptr };
+    OversamplingMode requestedMode;                  // under pathLock
+    bool isPathPrepared = false;                     // under pathLock
+    std::atomic<int>   latency{ 0 };
+    std::atomic<float> latestBloom{ 0.0f };          // starting point for new paths
+    int fadeLength = 0, fadePos = 0;
+    bool pathMidSide = false;                        // what the active path is fed
+    bool modeFade = false;                           // fadingPath is the twin, in the other mode
+
+    juce::CriticalSection pathLock;                  // never taken on the audio thread
+    juce::dsp::ProcessSpec preparedSpec{};
+
+    std::unique_ptr<Path> makeColourPath(OversamplingMode mode) const;
+    void processChunk(Block io) noexcept;
+    void crossfadePaths(Block& dry, Block& colour) noexcept;
+    void processModes(Block& dry, Block& colour) noexcept;
+    void crossfadeModes(Block& dry, Block& colour, typename Mixer::Ramp bloom,
+                        typename Mixer::Ramp dryGain) noexcept;
+    void bloomMix(Block& dry, Block& colour, bool midSide, Block* send,
+                  typename Mixer::Ramp bloom, typename Mixer::Ramp dryGain) noexcept;
+    void switchReverbOrder() noexcept;
+    FdnReverbBase::Parameters getRunningReverbParameters() noexcept;
+    void addOutgoingTail(Block& wet) noexcept;
+    void ringOutReverb(Block& io, SampleType outGain) noexcept;
+
+    BlockSmoother<SampleType> bloomSm;   // ramps rendered once per block, see BlockSmoother.h
+    BlockSmoother<SampleType> wetSm;
+    BlockSmoother<SampleType> sideSm;    // bloomSide
+    BlockSmoother<SampleType> lowCutSm;  // 0 / 1: low cut crossfade
+    BlockSmoother<SampleType> activeSm;  // 1 processing, 0 bypassed
+    Mixer                     mixer;     // Bloom / reverb / output-gain mix in one sweep
+
+    SampleType clipPeak = 0;             // into the soft clip, see takeClipGainReductionDb()
+    SampleType prevInGain = 1;
+    SampleType prevOutGain = 1;
+
+    JUCE_DECLARE_NON_COPYABLE(AirBloomEngine)
+};
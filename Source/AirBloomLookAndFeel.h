@@ -1,15 +1,15 @@
 // Source/LookAndFeel.h
 #pragma once
 #include <JuceHeader.h>
+#include "FilmStrip.h"
 
 class AirBloomLookAndFeel : public juce::LookAndFeel_V4
 {
 public:
+    static constexpr int knobFrames = 257;      // frames in knob_big1
+
     AirBloomLookAndFeel()
     {
-        knobStrip = juce::ImageCache::getFromMemory(BinaryData::knob_big1_png, BinaryData::knob_big1_pngSize);
-        buttonOnImage = juce::ImageCache::getFromMemory(BinaryData::button_small_on_png, BinaryData::button_small_on_pngSize);
-        buttonOffImage = juce::ImageCache::getFromMemory(BinaryData::button_small_off_png, BinaryData::button_small_off_pngSize);
         menuBg = juce::ImageCache::getFromMemory(BinaryData::menu_background_png, BinaryData::menu_background_pngSize);
         alertBg = juce::ImageCache::getFromMemory(BinaryData::articulations_back_png, BinaryData::articulations_back_pngSize);
     }
@@ -38,22 +38,14 @@ public:
         g.setFont(14.0f);
     }
 
-    // film-strip knob drawing unchanged...
+    // film-strip knob: a pre-scaled frame, blitted (see FilmStrip.h)
     void drawRotarySlider(juce::Graphics& g, int x, int y, int width, int height,
         float sliderPosProportional, float, float, juce::Slider&) override
     {
-        if (knobStrip.isValid())
+        if (skin->knob.isValid())
         {
-            constexpr int numFrames = 257;
-            int frameW = knobStrip.getWidth();
-            int frameH = knobStrip.getHeight() / numFrames;
-            int idx = juce::jlimit(0, numFrames - 1,
-                int(std::floor(sliderPosProportional * (numFrames - 1) + 0.5f)));
-
-            g.drawImage(knobStrip,
-                x, y, width, height,
-                0, idx * frameH, frameW, frameH,
-                false);
+            skin->knob.draw(g, { x, y, width, height },
+                FilmStrip::frameFor(sliderPosProportional, knobFrames));
             return;
         }
 
@@ -111,9 +103,7 @@ public:
         // Only skin plain TextButtons (ToggleButtons already handled)
         if (dynamic_cast<juce::TextButton*> (&b) != nullptr)
         {
-            const auto& img = isDown ? buttonOnImage : buttonOffImage;
-            g.drawImage(img, b.getLocalBounds().toFloat(),
-                juce::RectanglePlacement::fillDestination);
+            drawButtonImage(g, isDown ? skin->buttonOn : skin->buttonOff, b.getLocalBounds());
             return;                                     // done
         }
 
@@ -125,13 +115,11 @@ public:
         bool /*isMouseOver*/, bool /*isButtonDown*/) override
     {
         auto bounds = btn.getLocalBounds().toFloat();
-        const auto& img = btn.getToggleState() ? buttonOnImage : buttonOffImage;
+        const auto& img = btn.getToggleState() ? skin->buttonOn : skin->buttonOff;
 
         if (img.isValid())
         {
-            g.drawImage(img,
-                bounds,
-                juce::RectanglePlacement::fillDestination);
+            drawButtonImage(g, img, btn.getLocalBounds());
         }
         else
         {
@@ -150,5 +138,25 @@ public:
     }
 
 private:
-    juce::Image knobStrip, buttonOnImage, buttonOffImage, menuBg, alertBg;
+    // the film-strip art, scaled once per size for every editor in the process
+    struct Skin
+    {
+        FilmStrip knob{ juce::ImageCache::getFromMemory(BinaryData::knob_big1_png, BinaryData::knob_big1_pngSize), knobFrames };
+        FilmStrip buttonOn{ juce::ImageCache::getFromMemory(BinaryData::button_small_on_png, BinaryData::button_small_on_pngSize), 1 };
+        FilmStrip buttonOff{ juce::ImageCache::getFromMemory(BinaryData::button_small_off_png, BinaryData::button_small_off_pngSize), 1 };
+    };
+
+    // fills the button, keeping the art's proportions (overhang is cropped)
+    static void drawButtonImage(juce::Graphics& g, const FilmStrip& img, juce::Rectangle<int> bounds)
+    {
+        const auto placed = juce::RectanglePlacement(juce::RectanglePlacement::fillDestination)
+                                .appliedTo(img.getFrameBounds(), bounds);
+
+        const juce::Graphics::ScopedSaveState save(g);
+        g.reduceClipRegion(bounds);
+        img.draw(g, placed, 0);
+    }
+
+    juce::SharedResourcePointer<Skin> skin;
+    juce::Image menuBg, alertBg;
 };
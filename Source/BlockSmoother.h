@@ -0,0 +1,86 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+
+/*  A SmoothedValue that is advanced once per block, not once per channel.
+
+    process() renders the ramp for the whole block into a scratch array;
+    every channel then mixes against that same ramp with vector ops. When
+    the value isn't moving, isRamping() is false and mixInto() falls back
+    to a scalar gain. SampleType is the type of the ramp and of the
+    signal it's mixed into.                                              */
+template <typename SampleType>
+class BlockSmoother
+{
+public:
+    void prepare(double sampleRate, double rampSeconds, int maxBlockSize)
+    {
+        sm.reset(sampleRate, rampSeconds);
+        ramp.allocate((size_t)juce::jmax(1, maxBlockSize), true);
+        capacity = juce::jmax(1, maxBlockSize);
+        ramping = false;
+    }
+
+    void setTargetValue(SampleType v) noexcept            { sm.setTargetValue(v); }
+    void setCurrentAndTargetValue(SampleType v) noexcept  { sm.setCurrentAndTargetValue(v); ramping = false; }
+
+    /* advance by numSamples – call once per block, before any mixInto() */
+    void process(int numSamples) noexcept
+    {
+        ramping = sm.isSmoothing();
+
+        if (!ramping)
+            return;
+
+        // the engine chunks to the prepared size, so this can't happen –
+        // and mustn't grow the ramp on the audio thread if it ever does:
+        // jump to where the ramp would have got to instead
+        jassert(numSamples <= capacity);
+
+        if (numSamples > capacity)
+        {
+            sm.skip(numSamples);
+            ramping = false;
+            return;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            ramp[i] = sm.getNextValue();
+    }
+
+    bool  isRamping() const noexcept           { return ramping; }
+    const SampleType* getRamp() const noexcept { return ramp.get(); }
+    SampleType getCurrentValue() const noexcept { return sm.getCurrentValue(); }
+
+    /* dest = dest·(1 − g) + src·g   (src is used as scratch and clobbered) */
+    void mixInto(SampleType* dest, SampleType* src, int numSamples) const noexcept
+    {
+        using FVO = juce::FloatVectorOperations;
+
+        if (ramping)
+        {
+            FVO::subtract(src, dest, numSamples);                 // src − dest
+            FVO::addWithMultiply(dest, src, ramp.get(), numSamples);
+            return;
+        }
+
+        const SampleType g = sm.getCurrentValue();
+
+        if (g <= SampleType(0))
+            return;
+
+        if (g >= SampleType(1))
+        {
+            FVO::copy(dest, src, numSamples);
+            return;
+        }
+
+        FVO::multiply(dest, SampleType(1) - g, numSamples);
+        FVO::addWithMultiply(dest, src, g, numSamples);
+    }
+
+private:
+    juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Linear> sm;
+    juce::HeapBlock<SampleType> ramp;
+    int  capacity = 0;
+    bool ramping = false;
+};
@@ -0,0 +1,129 @@
+#include "ColourPath.h"
+
+//===========================================================================
+template <typename SampleType>
+ColourPath<SampleType>::ColourPath(OversamplingMode m)
+    : mode(m)
+{
+}
+
+//===========================================================================
+// message thread / prepareToPlay – allowed to allocate
+template <typename SampleType>
+void ColourPath<SampleType>::prepare(const juce::dsp::ProcessSpec& spec,
+                                     float maxShelfDb, float maxDriveDb, float initialBloom)
+{
+    driveDbPerBloom = maxDriveDb;
+
+    oversampler = mode.createOversampler<SampleType>(spec.numChannels);
+
+    if (oversampler != nullptr)
+    {
+        oversampler->initProcessing(spec.maximumBlockSize);
+
+        latency = juce::roundToInt(oversampler->getLatencyInSamples());
+    }
+    else
+    {
+        latency = 0;
+    }
+
+    const double hiRate = spec.sampleRate * (double)mode.getFactor();
+    shelfTable.build(hiRate, maxShelfDb);
+
+    shelfFilter.prepare(spec);
+    shelfFilter.setCoefficients(*juce::dsp::IIR::Coefficients<SampleType>::makeHighShelf(
+        hiRate, ShelfCoefficientTable::cutoffHz, ShelfCoefficientTable::shelfQ, SampleType(1)));
+
+    driveGain.prepare(spec);
+    driveGain.setGainLinear(SampleType(1));
+    softClipper.prepare(spec);
+
+    dryDelay.setMaximumDelayInSamples(juce::jmax(1, latency));
+    dryDelay.prepare(spec);
+    dryDelay.setDelay((SampleType)latency);
+
+    shelfSm.reset(spec.sampleRate, 0.05);   // 50 ms ramp
+    shelfSm.setCurrentAndTargetValue(initialBloom);
+}
+
+template <typename SampleType>
+void ColourPath<SampleType>::reset() noexcept
+{
+    if (oversampler != nullptr)
+        oversampler->reset();
+
+    shelfFilter.reset();
+    driveGain.reset();
+    dryDelay.reset();
+}
+
+//===========================================================================
+// audio thread
+template <typename SampleType>
+void ColourPath<SampleType>::process(const juce::dsp::AudioBlock<SampleType>& colour,
+                                     const juce::dsp::AudioBlock<SampleType>& dry) noexcept
+{
+    const int numSmp = (int)colour.getNumSamples();
+
+    if (oversampler != nullptr)
+    {
+        auto base = colour;
+        auto upBlock = oversampler->processSamplesUp(base);     // oversample
+        runColour(upBlock, numSmp);
+        oversampler->processSamplesDown(base);                  // back to 1×
+
+        delayDry(dry);
+    }
+    else
+    {
+        auto base = colour;
+        runColour(base, numSmp);
+    }
+}
+
+template <typename SampleType>
+void ColourPath<SampleType>::delayDry(const juce::dsp::AudioBlock<SampleType>& dry) noexcept
+{
+    if (latency == 0)
+        return;
+
+    auto d = dry;
+    juce::dsp::ProcessContextReplacing<SampleType> dctx(d);
+    dryDelay.process(dctx);
+}
+
+// shelf + drive follow a ramped Bloom value; coefficients come from the
+// pre-computed table and are written in place, once per sub-block
+template <typename SampleType>
+void ColourPath<SampleType>::runColour(juce::dsp::AudioBlock<SampleType>& block, int numBaseSamples) noexcept
+{
+    const int factor = mode.getFactor();
+
+    for (int start = 0; start < numBaseSamples; start += shelfSubBlock)
+    {
+        const int   n = juce::jmin(shelfSubBlock, numBaseSamples - start);
+        const float b = shelfSm.skip(n);
+
+        shelfTable.lookup(b, shelfFilter.getRawCoefficients());
+        driveGain.setGainLinear((SampleType)juce::Decibels::decibelsToGain(b * driveDbPerBloom));
+
+        auto sub = block.getSubBlock((size_t)(start * factor), (size_t)(n * factor));
+        juce::dsp::ProcessContextReplacing<SampleType> ctx(sub);
+        shelfFilter.process(ctx);
+        driveGain.process(ctx);
+    }
+
+    for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+    {
+        const auto r = juce::FloatVectorOperations::findMinAndMax(block.getChannelPointer(ch),
+                                                                  (int)block.getNumSamples());
+        clipPeak = juce::jmax(clipPeak, -r.getStart(), r.getEnd());
+    }
+
+    juce::dsp::ProcessContextReplacing<SampleType> ctx(block);
+    softClipper.process(ctx);
+}
+
+template class ColourPath<float>;
+template class ColourPath<double>;
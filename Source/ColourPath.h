@@ -0,0 +1,78 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include "ShelfCoefficientTable.h"
+#include "SoftClipKernel.h"
+#include "OversamplingMode.h"
+#include "MultichannelBiquad.h"
+#include <utility>
+
+/*  One complete Bloom colour stage for a single oversampling mode:
+    oversampler (none at 1×), shelf, drive and soft clip, plus the delay
+    that keeps the dry signal lined up with the oversampler's latency.
+
+    Paths are built and prepared off the audio thread; the processor
+    only ever holds the one for the selected mode, plus the outgoing
+    one while it crossfades between them. A stereo path can carry a twin
+    – a second path for the same mode – so switching the Bloom mode
+    (L/R ↔ M/S) can crossfade too without building anything on the
+    audio thread. Instantiated for float and double in ColourPath.cpp. */
+template <typename SampleType>
+class ColourPath
+{
+public:
+    /* mode should already be resolved for realtime / offline rendering */
+    explicit ColourPath(OversamplingMode mode);
+
+    /* maxShelfDb / maxDriveDb are the shelf boost and drive at Bloom = 1 */
+    void prepare(const juce::dsp::ProcessSpec& spec,
+                 float maxShelfDb, float maxDriveDb, float initialBloom);
+    void reset() noexcept;
+
+    const OversamplingMode& getMode() const noexcept { return mode; }
+    int getLatencySamples() const noexcept { return latency; }
+
+    void setBloomTarget(float bloom) noexcept { shelfSm.setTargetValue(bloom); }
+    void snapBloom(float bloom) noexcept { shelfSm.setCurrentAndTargetValue(bloom); }
+
+    /* colour: in/out, replaced by the Bloom-coloured signal
+       dry:    in/out, delayed by getLatencySamples() so both line up     */
+    void process(const juce::dsp::AudioBlock<SampleType>& colour,
+                 const juce::dsp::AudioBlock<SampleType>& dry) noexcept;
+
+    /* just the dry delay – bypass still owes the host the reported latency,
+       and the line has to stay current for when bypass comes off */
+    void delayDry(const juce::dsp::AudioBlock<SampleType>& dry) noexcept;
+
+    /* the spare path riding along with this one (audio thread once handed
+       over); null if it was never given one or it's out being used */
+    void setTwin(std::unique_ptr<ColourPath> p) noexcept { twin = std::move(p); }
+    std::unique_ptr<ColourPath> takeTwin() noexcept { return std::move(twin); }
+
+    /* highest |sample| into the soft clip since the last call (the clip is
+       monotonic, so that's all its gain reduction needs) */
+    SampleType takeClipPeak() noexcept { return std::exchange(clipPeak, SampleType(0)); }
+
+private:
+    void runColour(juce::dsp::AudioBlock<SampleType>& block, int numBaseSamples) noexcept;
+
+    using Shelf = MultichannelBiquad<SampleType>;     // all channels in SIMD lanes
+
+    const OversamplingMode mode;
+    int       latency = 0;
+    float     driveDbPerBloom = 0.0f;
+    SampleType clipPeak = 0;
+
+    std::unique_ptr<juce::dsp::Oversampling<SampleType>> oversampler;   // null at 1×
+    ShelfCoefficientTable       shelfTable;
+    Shelf                       shelfFilter;
+    juce::dsp::Gain<SampleType> driveGain;
+    SoftClipper                 softClipper;
+
+    juce::dsp::DelayLine<SampleType, juce::dsp::DelayLineInterpolationTypes::None> dryDelay;
+
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> shelfSm;
+    std::unique_ptr<ColourPath> twin;
+    static constexpr int shelfSubBlock = 32;   // coefficient update rate (base-rate samples)
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ColourPath)
+};
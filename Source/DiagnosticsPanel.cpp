@@ -0,0 +1,73 @@
+#include "DiagnosticsPanel.h"
+
+namespace
+{
+    constexpr int refreshHz = 4;
+    constexpr int rowHeight = 14;
+}
+
+//===========================================================================
+DiagnosticsPanel::DiagnosticsPanel(StageProfiler& p) : profiler(p)
+{
+    setSize(260, rowHeight * (StageProfiler::numStages + 1) + 8);
+}
+
+// only poll while it's on screen
+void DiagnosticsPanel::visibilityChanged()
+{
+    if (isVisible())
+    {
+        timerCallback();
+        startTimerHz(refreshHz);
+    }
+    else
+    {
+        stopTimer();
+    }
+}
+
+void DiagnosticsPanel::timerCallback()
+{
+    for (int s = 0; s < StageProfiler::numStages; ++s)
+        shown[(size_t)s] = profiler.getSummary(s);
+
+    repaint();
+}
+
+void DiagnosticsPanel::mouseDown(const juce::MouseEvent&)
+{
+    profiler.reset();
+}
+
+void DiagnosticsPanel::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black.withAlpha(0.8f));
+    g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 11.0f, juce::Font::plain));
+
+    auto row = [&, y = 4](const juce::String& name, const juce::String& a, const juce::String& b,
+                          const juce::String& c, const juce::String& n) mutable
+    {
+        const int w = getWidth() - 8;
+        const int col = (w - 70) / 4;
+
+        g.drawText(name, 4, y, 70, rowHeight, juce::Justification::centredLeft);
+        g.drawText(a, 74, y, col, rowHeight, juce::Justification::centredRight);
+        g.drawText(b, 74 + col, y, col, rowHeight, juce::Justification::centredRight);
+        g.drawText(c, 74 + col * 2, y, col, rowHeight, juce::Justification::centredRight);
+        g.drawText(n, 74 + col * 3, y, col, rowHeight, juce::Justification::centredRight);
+        y += rowHeight;
+    };
+
+    g.setColour(juce::Colours::grey);
+    row("us / chunk", "p50", "p99", "max", "chunks");
+
+    g.setColour(juce::Colours::white);
+    for (int s = 0; s < StageProfiler::numStages; ++s)
+    {
+        const auto& sum = shown[(size_t)s];
+        auto us = [&](double v) { return sum.count > 0 ? juce::String(v, 1) : juce::String("-"); };
+
+        row(StageProfiler::getStageName(s), us(sum.p50), us(sum.p99), us(sum.max),
+            juce::String((juce::int64)sum.count));
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <JuceHeader.h>
+#include "StageProfiler.h"
+
+/*  Per-stage engine timings as a small table: p50 / p99 / max per
+    chunk in microseconds, read from the processor's StageProfiler a few
+    times a second. Hidden in the editor (double-click the logo), and only
+    built into it with AIRBLOOM_PROFILE_STAGES. Click the panel to start
+    the figures over.                                                    */
+class DiagnosticsPanel : public juce::Component,
+                         private juce::Timer
+{
+public:
+    explicit DiagnosticsPanel(StageProfiler& p);
+
+    void paint(juce::Graphics&) override;
+    void mouseDown(const juce::MouseEvent&) override;
+    void visibilityChanged() override;
+
+private:
+    void timerCallback() override;
+
+    StageProfiler& profiler;
+    std::array<StageProfiler::Summary, StageProfiler::numStages> shown;
+};
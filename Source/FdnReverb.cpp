@@ -0,0 +1,439 @@
+#include "FdnReverb.h"
+
+namespace
+{
+    // delay lengths at size = 1, spread log-evenly across this range
+    constexpr double shortestMs = 23.0;
+    constexpr double longestMs = 97.0;
+    constexpr double glideSeconds = 0.1;     // size changes glide this long
+
+    int clampOrder(int o) noexcept
+    {
+        return o <= 4 ? 4 : (o <= 8 ? 8 : 16);
+    }
+
+    float sizeScale(float size) noexcept
+    {
+        return 0.3f + 0.7f * juce::jlimit(0.0f, 1.0f, size);
+    }
+
+    // entry (row, col) of the Sylvester–Hadamard matrix: ±1, rows orthogonal
+    int hadamard(int row, int col) noexcept
+    {
+        int bits = row & col, parity = 0;
+        for (; bits != 0; bits &= bits - 1)
+            parity ^= 1;
+
+        return parity != 0 ? -1 : 1;
+    }
+
+    template <typename SampleType>
+    SampleType peakOf(const SampleType* d, int n) noexcept
+    {
+        const auto r = juce::FloatVectorOperations::findMinAndMax(d, n);
+        return juce::jmax(-r.getStart(), r.getEnd());
+    }
+}
+
+//===========================================================================
+template <typename SampleType>
+void FdnReverb<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+    numChannels = juce::jmin((int)spec.numChannels, maxChannels);
+
+    const int longest = (int)std::ceil(longestMs * 0.001 * sampleRate) + 2;
+    lineSize = juce::nextPowerOfTwo(longest);
+    mask = lineSize - 1;
+
+    lines.allocate((size_t)(maxOrder * lineSize), true);
+
+    order = clampOrder(params.order);
+    updateTargets(Delays::snap);
+    reset();
+}
+
+template <typename SampleType>
+void FdnReverb<SampleType>::reset() noexcept
+{
+    // lines past the current order are never read, and get cleared when
+    // an order change brings them back
+    if (lines != nullptr)
+        juce::FloatVectorOperations::clear(lines.get(), order * lineSize);
+
+    lowpass.fill(0);
+    writePos = 0;
+    asleep = true;
+    quietSamples = 0;
+}
+
+double FdnReverbBase::getTailSeconds(const Parameters& p) noexcept
+{
+    return juce::jmax(0.05, (double)p.decaySeconds) + longestMs * 0.001;
+}
+
+//===========================================================================
+template <typename SampleType>
+void FdnReverb<SampleType>::setParameters(const Parameters& p) noexcept
+{
+    const bool orderChanged = clampOrder(p.order) != order;
+    const bool sizeChanged = !juce::approximatelyEqual(p.size, params.size);
+    const bool other = !juce::approximatelyEqual(p.decaySeconds, params.decaySeconds)
+                    || !juce::approximatelyEqual(p.damping, params.damping)
+                    || p.decorrelate != params.decorrelate;
+
+    if (!orderChanged && !sizeChanged && !other)
+        return;
+
+    params = p;
+
+    if (orderChanged)
+    {
+        // different network – start it from silence
+        order = clampOrder(p.order);
+        updateTargets(Delays::snap);
+        reset();
+        return;
+    }
+
+    // only a new size moves the delays; decay or damping alone just
+    // changes the loop gains, with no glide through the interpolated reads
+    updateTargets(sizeChanged ? Delays::glide : Delays::keep);
+}
+
+template <typename SampleType>
+int FdnReverb<SampleType>::getNumIo() const noexcept
+{
+    return (params.decorrelate && numChannels > 2) ? numChannels : 2;
+}
+
+// delay lengths, decay gains, injection / tap signs for the current
+// order; audio-thread safe (no allocation)
+template <typename SampleType>
+void FdnReverb<SampleType>::updateTargets(Delays delays) noexcept
+{
+    // not prepared yet: there are no lines to fit the delays into, and
+    // prepare() works the targets out from params anyway
+    if (lineSize == 0)
+        return;
+
+    const double scale = (double)sizeScale(params.size);
+    const double rt60 = juce::jmax(0.05, (double)params.decaySeconds);
+
+    numIo = getNumIo();
+    const bool bed = numIo > 2;
+
+    // stereo: each side owns half the lines; bed / mono: every channel all of them
+    const auto tapGain = (SampleType)(1.0 / std::sqrt((double)(bed ? order : order / 2)));
+    const auto tapGainAll = (SampleType)(1.0 / std::sqrt((double)order));
+    const auto injectGain = (SampleType)(bed ? 1.0 / std::sqrt((double)numIo) : 1.0);
+
+    for (auto* v : { &inject, &tap })
+        for (auto& line : *v)
+            line.fill(0);
+
+    injectAll.fill(0);
+    tapAll.fill(0);
+
+    for (int j = 0; j < maxOrder; ++j)
+    {
+        if (j >= order)
+        {
+            targetDelay[(size_t)j] = delay[(size_t)j] = 1;
+            delayStep[(size_t)j] = 0;
+            gain[(size_t)j] = 0;
+            continue;
+        }
+
+        const double t = (double)j / (double)(order - 1);
+        const double ms = shortestMs * std::pow(longestMs / shortestMs, t);
+        // a little irrational detune keeps the lengths from sharing factors
+        const double len = juce::jlimit(2.0, (double)(lineSize - 2),
+                                        ms * 0.001 * sampleRate * scale * (1.0 + 0.013 * std::sin(7.1 * j)));
+
+        targetDelay[(size_t)j] = (SampleType)len;
+
+        // RT60: −60 dB after rt60 seconds, however long each loop is
+        gain[(size_t)j] = (SampleType)std::pow(10.0, -3.0 * len / (rt60 * sampleRate));
+
+        // mono: the L and R injections together, so a mono send drives
+        // the lines exactly as the same signal on both sides would
+        const SampleType sign = ((j / 2) % 2 == 0) ? SampleType(1) : SampleType(-1);
+        injectAll[(size_t)j] = sign;
+        tapAll[(size_t)j] = sign * tapGainAll;
+
+        if (bed)
+        {
+            // row 0 (all +1) is the Householder sum direction – use it last
+            for (int c = 0; c < numIo; ++c)
+            {
+                const auto h = (SampleType)hadamard((c + 1) % order, j);
+                inject[(size_t)c][(size_t)j] = h * injectGain;
+                tap[(size_t)c][(size_t)j] = h * tapGain;
+            }
+        }
+        else
+        {
+            const auto side = (size_t)(j % 2);          // 0 = left, 1 = right
+            inject[side][(size_t)j] = sign;
+            tap[side][(size_t)j] = sign * tapGain;
+        }
+    }
+
+    damp = (SampleType)(0.85f * juce::jlimit(0.0f, 1.0f, params.damping));
+    outScale = (SampleType)0.5;
+
+    if (delays == Delays::keep)
+        return;
+
+    if (delays == Delays::snap)
+    {
+        delay = targetDelay;
+        delayStep.fill(0);
+        rampLeft = 0;
+        return;
+    }
+
+    rampLeft = juce::jmax(1, juce::roundToInt(glideSeconds * sampleRate));
+    for (int j = 0; j < order; ++j)
+        delayStep[(size_t)j] = (targetDelay[(size_t)j] - delay[(size_t)j]) / (SampleType)rampLeft;
+}
+
+//===========================================================================
+template <typename SampleType>
+void FdnReverb<SampleType>::process(const juce::dsp::ProcessContextReplacing<SampleType>& ctx) noexcept
+{
+    auto& block = ctx.getOutputBlock();
+    const auto numCh = block.getNumChannels();
+
+    if (numCh == 0 || block.getNumSamples() == 0)
+        return;
+
+    if (ctx.isBypassed)
+    {
+        block.clear();
+        return;
+    }
+
+    // the channels the network reads and writes: one mono channel, L/R,
+    // or every channel of a bed
+    Routing r;
+    const bool bed = numIo > 2;
+
+    if (numCh == 1)
+    {
+        r.numIn = r.numOut = 1;
+        r.inject = &injectAll;
+        r.tap = &tapAll;
+    }
+    else
+    {
+        r.numIn = r.numOut = bed ? juce::jmin(numIo, (int)numCh) : 2;
+        r.inject = inject.data();
+        r.tap = tap.data();
+    }
+
+    for (int c = 0; c < r.numOut; ++c)
+        r.in[c] = r.out[c] = block.getChannelPointer((size_t)c);
+
+    if (!processRouted(r, block) || bed)
+        return;
+
+    // stereo mode: any extra channels get the L/R pair
+    for (size_t ch = 2; ch < numCh; ++ch)
+        juce::FloatVectorOperations::copy(block.getChannelPointer(ch), r.out[ch % 2],
+                                          (int)block.getNumSamples());
+}
+
+template <typename SampleType>
+void FdnReverb<SampleType>::process(const juce::dsp::ProcessContextNonReplacing<SampleType>& ctx) noexcept
+{
+    auto& input = ctx.getInputBlock();
+    auto& output = ctx.getOutputBlock();
+    const auto numCh = output.getNumChannels();
+
+    jassert(input.getNumSamples() == output.getNumSamples());
+
+    if (numCh == 0 || input.getNumChannels() == 0 || output.getNumSamples() == 0)
+        return;
+
+    if (ctx.isBypassed)
+    {
+        output.clear();
+        return;
+    }
+
+    // the mono send drives every line, the taps are the usual L/R ones
+    Routing r;
+    r.numIn = 1;
+    r.in[0] = input.getChannelPointer(0);
+    r.inject = &injectAll;
+    r.numOut = numCh >= 2 ? 2 : 1;
+    r.tap = numCh >= 2 ? tap.data() : &tapAll;
+
+    for (int c = 0; c < r.numOut; ++c)
+        r.out[c] = output.getChannelPointer((size_t)c);
+
+    if (!processRouted(r, output))
+        return;
+
+    for (size_t ch = 2; ch < numCh; ++ch)
+        juce::FloatVectorOperations::copy(output.getChannelPointer(ch), r.out[ch % 2],
+                                          (int)output.getNumSamples());
+}
+
+template <typename SampleType>
+bool FdnReverb<SampleType>::processRouted(const Routing& r,
+                                          const juce::dsp::AudioBlock<SampleType>& output) noexcept
+{
+    const int numSmp = (int)output.getNumSamples();
+
+    auto peak = [numSmp](auto* const* chans, int n)
+    {
+        SampleType p = 0;
+        for (int c = 0; c < n; ++c)
+            p = juce::jmax(p, peakOf(chans[c], numSmp));
+        return p;
+    };
+
+    // processing may be in place, so look at the input before it's overwritten
+    const bool silentIn = peak(r.in, r.numIn) < (SampleType)silenceThreshold;
+
+    if (asleep)
+    {
+        if (silentIn)
+        {
+            output.clear();
+            return false;
+        }
+
+        asleep = false;
+        quietSamples = 0;
+    }
+
+    int done = 0;
+
+    // glide part of the block with interpolated reads, the rest is integer
+    if (rampLeft > 0)
+    {
+        const int len = juce::jmin(rampLeft, numSmp);
+        processLoop<true>(r, done, len);
+        rampLeft -= len;
+        done += len;
+
+        if (rampLeft == 0)
+        {
+            delay = targetDelay;
+            delayStep.fill(0);
+        }
+    }
+
+    if (done < numSmp)
+        processLoop<false>(r, done, numSmp - done);
+
+    // nothing in, nothing (audible) out for a whole loop length → sleep
+    if (silentIn && peak(r.out, r.numOut) < (SampleType)silenceThreshold)
+    {
+        quietSamples += numSmp;
+
+        if (quietSamples >= lineSize)
+        {
+            reset();
+            output.clear();
+            return false;
+        }
+    }
+    else
+    {
+        quietSamples = 0;
+    }
+
+    return true;
+}
+
+template <typename SampleType>
+template <bool Interpolate>
+void FdnReverb<SampleType>::processLoop(const Routing& r, int start, int numSamples) noexcept
+{
+    const int        numVec = (order + lanes - 1) / lanes;
+    const SampleType mixScale = SampleType(2) / (SampleType)order;
+    const Vec        dampV = Vec::expand(damp);
+
+    alignas(32) std::array<SampleType, maxOrder> x{};
+    SampleType* const base = lines.get();
+
+    Vec in[maxChannels], y[maxChannels];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // 1) read every line
+        for (int j = 0; j < order; ++j)
+        {
+            const SampleType* line = base + j * lineSize;
+
+            if (Interpolate)
+            {
+                delay[(size_t)j] += delayStep[(size_t)j];
+                const SampleType d = delay[(size_t)j];
+                const int        di = (int)d;
+                const SampleType frac = d - (SampleType)di;
+                const SampleType a = line[(writePos - di) & mask];
+                const SampleType b = line[(writePos - di - 1) & mask];
+                x[(size_t)j] = a + frac * (b - a);
+            }
+            else
+            {
+                x[(size_t)j] = line[(writePos - (int)delay[(size_t)j]) & mask];
+            }
+        }
+
+        // 2) damping, output taps, Householder feedback – all vectorised
+        Vec sum = Vec::expand(0);
+
+        for (int c = 0; c < r.numIn; ++c)
+            in[c] = Vec::expand(r.in[c][start + i]);
+
+        for (int c = 0; c < r.numOut; ++c)
+            y[c] = sum;
+
+        for (int k = 0; k < numVec; ++k)
+        {
+            const auto o = (size_t)(k * lanes);
+            const Vec v = Vec::fromRawArray(x.data() + o);
+            Vec lp = Vec::fromRawArray(lowpass.data() + o);
+
+            lp = v + (lp - v) * dampV;
+            lp.copyToRawArray(lowpass.data() + o);
+
+            sum += lp;
+            for (int c = 0; c < r.numOut; ++c)
+                y[c] += lp * Vec::fromRawArray(r.tap[c].data() + o);
+        }
+
+        const Vec s = Vec::expand(sum.sum() * mixScale);
+
+        for (int k = 0; k < numVec; ++k)
+        {
+            const auto o = (size_t)(k * lanes);
+            const Vec lp = Vec::fromRawArray(lowpass.data() + o);
+
+            Vec fb = (lp - s) * Vec::fromRawArray(gain.data() + o);
+            for (int c = 0; c < r.numIn; ++c)
+                fb += in[c] * Vec::fromRawArray(r.inject[c].data() + o);
+
+            fb.copyToRawArray(x.data() + o);
+        }
+
+        // 3) write back
+        for (int j = 0; j < order; ++j)
+            base[j * lineSize + writePos] = x[(size_t)j];
+
+        writePos = (writePos + 1) & mask;
+
+        for (int c = 0; c < r.numOut; ++c)
+            r.out[c][start + i] = y[c].sum() * outScale;
+    }
+}
+
+template class FdnReverb<float>;
+template class FdnReverb<double>;
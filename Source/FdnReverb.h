@@ -0,0 +1,126 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+
+/*  Feedback-delay-network reverb for the Atmos send (replaces Freeverb).
+
+    4, 8 or 16 delay lines on power-of-two ring buffers, a one-pole
+    damping filter and a per-line decay gain in each loop, and a
+    Householder feedback matrix  y = x − (2/N)·Σx  done with
+    juce::dsp::SIMDRegister. Left input feeds the even lines and left
+    output taps them, right uses the odd ones.
+
+    On a bed (more than two channels) with `decorrelate` on, every
+    channel feeds and taps all the lines through its own row of a
+    Hadamard matrix instead, so each speaker gets a tail uncorrelated
+    with the others – up to 16 distinct rows with 16 lines, fewer lines
+    repeat them. Input is scaled so a full bed drives the network about
+    as hard as a stereo pair. With it off, channels past two get a copy
+    of the L/R pair.
+
+    A mono signal feeds every line: a mono block gets a mono fold of the
+    whole network, and the non-replacing process() turns one input into
+    an L/R tail without anyone copying the input to a second channel.
+
+    Decay (RT60), size and damping can move every block: size changes
+    glide the delay lengths over 100 ms with interpolated reads, so they
+    don't click. Changing the order clears the tail.
+
+    Runs in float or double; FdnReverbBase holds what doesn't depend on
+    the sample type, so both share one Parameters.                      */
+class FdnReverbBase
+{
+public:
+    static constexpr int maxOrder = 16;
+    static constexpr int maxChannels = 16;
+    static constexpr float silenceThreshold = 1.0e-5f;    // −100 dB
+
+    struct Parameters
+    {
+        int   order = 8;            // 4, 8 or 16
+        float decaySeconds = 1.5f;  // RT60
+        float size = 0.8f;          // 0…1, scales the delay lengths
+        float damping = 0.2f;       // 0…1, high-frequency loss per loop
+        bool  decorrelate = true;   // beds: a separate tail per channel
+    };
+
+    /* RT60 plus one trip round the longest loop */
+    static double getTailSeconds(const Parameters& p) noexcept;
+};
+
+template <typename SampleType>
+class FdnReverb : public FdnReverbBase
+{
+public:
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset() noexcept;
+
+    /* audio thread, once per block is fine */
+    void setParameters(const Parameters& p) noexcept;
+    const Parameters& getParameters() const noexcept { return params; }
+
+    /* pure wet; channel 0/1 are L/R (a mono block gets a mono fold) */
+    void process(const juce::dsp::ProcessContextReplacing<SampleType>& ctx) noexcept;
+
+    /* mono in (channel 0 of the input), L/R tail out; the input may be
+       the output's first channel */
+    void process(const juce::dsp::ProcessContextNonReplacing<SampleType>& ctx) noexcept;
+
+    /* Goes true once input and output have stayed under silenceThreshold
+       for longer than the longest loop; the lines are cleared then, and
+       process() just writes silence until the input comes back. Callers
+       can skip the stage entirely while it's asleep and the send is
+       silent – it wakes from an empty state, so there's nothing to click. */
+    bool isAsleep() const noexcept { return asleep; }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr int lanes = (int)Vec::SIMDNumElements;
+    static_assert(maxOrder % lanes == 0, "per-line arrays must fill whole registers");
+
+    using LineVector = std::array<SampleType, maxOrder>;
+
+    /* which channels feed and tap the lines, through which rows; every
+       input sample is read before the outputs for it are written, so
+       in[c] and out[c] may be the same channel */
+    struct Routing
+    {
+        const SampleType* in[maxChannels] = {};
+        SampleType*       out[maxChannels] = {};
+        const LineVector* inject = nullptr;
+        const LineVector* tap = nullptr;
+        int numIn = 0, numOut = 0;
+    };
+
+    /* false if the network is (or just went) asleep and output is cleared */
+    bool processRouted(const Routing& r, const juce::dsp::AudioBlock<SampleType>& output) noexcept;
+
+    template <bool Interpolate>
+    void processLoop(const Routing& r, int start, int numSamples) noexcept;
+
+    // what updateTargets() does with the delay lengths: jump to them,
+    // glide to them over glideSeconds, or leave them (and any glide still
+    // running) alone – decay, damping and routing don't move them
+    enum class Delays { snap, glide, keep };
+    void updateTargets(Delays) noexcept;
+    int  getNumIo() const noexcept;
+
+    double sampleRate = 44100.0;
+    Parameters params;
+    int order = 8;
+    int numChannels = 2;                     // as prepared
+    int numIo = 2;                           // channels the network feeds / taps
+
+    juce::HeapBlock<SampleType> lines;       // maxOrder × lineSize, contiguous
+    int lineSize = 0, mask = 0, writePos = 0;
+
+    int rampLeft = 0;                        // samples until delays reach target
+    alignas(32) std::array<SampleType, maxOrder> delay{}, delayStep{}, targetDelay{};
+    alignas(32) std::array<SampleType, maxOrder> gain{}, lowpass{};
+    alignas(32) std::array<LineVector, maxChannels> inject{}, tap{};    // per io channel
+    alignas(32) LineVector injectAll{}, tapAll{};                       // mono: every line
+    SampleType damp = 0, outScale = 1;
+
+    bool asleep = true;                      // state is all zeros
+    int  quietSamples = 0;
+};
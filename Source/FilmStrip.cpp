@@ -0,0 +1,134 @@
+#include "FilmStrip.h"
+
+FilmStrip::FilmStrip(const juce::Image& strip, int frames)
+    : source(strip),
+      numFrames(juce::jmax(1, frames))
+{
+    if (source.isValid())
+    {
+        frameW = source.getWidth();
+        frameH = source.getHeight() / numFrames;
+    }
+}
+
+int FilmStrip::frameFor(float proportion, int numFrames) noexcept
+{
+    return juce::jlimit(0, numFrames - 1,
+                        int(std::floor(proportion * (float)(numFrames - 1) + 0.5f)));
+}
+
+//===========================================================================
+const juce::Image& FilmStrip::getScaled(int width, int height, int frame) const
+{
+    auto it = std::find_if(sizes.begin(), sizes.end(),
+                           [&](const Scaled& s) { return s.width == width && s.height == height; });
+
+    if (it == sizes.end())
+    {
+        // a new size: make room by dropping the one unused longest
+        if ((int)sizes.size() >= maxSizes)
+            sizes.erase(std::min_element(sizes.begin(), sizes.end(),
+                                         [](const Scaled& a, const Scaled& b) { return a.lastUsed < b.lastUsed; }));
+
+        sizes.push_back({ width, height, std::vector<juce::Image>((size_t)numFrames), 0 });
+        it = sizes.end() - 1;
+    }
+
+    it->lastUsed = ++useCounter;
+    auto& image = it->frames[(size_t)frame];
+
+    if (!image.isValid())
+        image = source.getClippedImage({ 0, frame * frameH, frameW, frameH })
+                      .rescaled(width, height, juce::Graphics::highResamplingQuality);
+
+    return image;
+}
+
+void FilmStrip::draw(juce::Graphics& g, juce::Rectangle<int> area, int frame) const
+{
+    if (!isValid() || area.isEmpty())
+        return;
+
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    const int width = juce::roundToInt((float)area.getWidth() * scale);
+    const int height = juce::roundToInt((float)area.getHeight() * scale);
+
+    if (width <= 0 || height <= 0)
+        return;
+
+    const auto& image = getScaled(width, height, juce::jlimit(0, numFrames - 1, frame));
+
+    // undo the display scale so each image pixel lands on one screen pixel
+    const juce::Graphics::ScopedSaveState save(g);
+    g.setImageResamplingQuality(juce::Graphics::lowResamplingQuality);
+    g.drawImageTransformed(image, juce::AffineTransform::scale(1.0f / scale)
+                                      .translated((float)area.getX(), (float)area.getY()));
+}
+
+//===========================================================================
+// Component::repaint() asks the cached image first and goes no further if it
+// says no; painting itself goes straight through to the component
+class FilmStripKnob::RepaintGate : public juce::CachedComponentImage
+{
+public:
+    explicit RepaintGate(FilmStripKnob& k) : knob(k) {}
+
+    void paint(juce::Graphics& g) override
+    {
+        shown = current();
+        knob.paintEntireComponent(g, false);
+    }
+
+    bool invalidateAll() override                         { return current() != shown; }
+    bool invalidate(const juce::Rectangle<int>&) override { return current() != shown; }
+    void releaseResources() override                      { forget(); }
+
+    void forget() noexcept { shown = {}; }
+
+private:
+    struct Key
+    {
+        int frame = -1, width = 0, height = 0;
+
+        bool operator!=(const Key& o) const noexcept
+        {
+            return frame != o.frame || width != o.width || height != o.height;
+        }
+    };
+
+    Key current() const noexcept { return { knob.getCurrentFrame(), knob.getWidth(), knob.getHeight() }; }
+
+    FilmStripKnob& knob;
+    Key shown;
+};
+
+FilmStripKnob::FilmStripKnob(int frames)
+    : numFrames(juce::jmax(1, frames))
+{
+    gate = new RepaintGate(*this);
+    setCachedComponentImage(gate);
+}
+
+FilmStripKnob::~FilmStripKnob()
+{
+    gate = nullptr;
+    setCachedComponentImage(nullptr);
+}
+
+int FilmStripKnob::getCurrentFrame() const noexcept
+{
+    return FilmStrip::frameFor((float)valueToProportionOfLength(getValue()), numFrames);
+}
+
+void FilmStripKnob::repaintAnyway()
+{
+    if (gate != nullptr)
+        gate->forget();
+
+    repaint();
+}
+
+void FilmStripKnob::visibilityChanged()      { juce::Slider::visibilityChanged();      repaintAnyway(); }
+void FilmStripKnob::parentHierarchyChanged() { juce::Slider::parentHierarchyChanged(); repaintAnyway(); }
+void FilmStripKnob::lookAndFeelChanged()     { juce::Slider::lookAndFeelChanged();     repaintAnyway(); }
+void FilmStripKnob::enablementChanged()      { juce::Slider::enablementChanged();      repaintAnyway(); }
@@ -0,0 +1,78 @@
+#pragma once
+#include <JuceHeader.h>
+
+/*  A vertical film strip (frames stacked top to bottom, or a single image)
+    drawn pixel for pixel.
+
+    The first time a frame is drawn at a given size it is resampled once,
+    at high quality, to the physical pixels it covers there (component size
+    × display scale), and kept. From then on drawing it is a 1:1 blit with
+    no resampling. Frames are scaled as they're first needed rather than
+    all up front, and only the last few sizes are kept – enough for every
+    knob on screen, and for moving the editor between two displays.
+
+    Message thread only. Hold one through a SharedResourcePointer and every
+    editor in the process draws from the same scaled frames.             */
+class FilmStrip
+{
+public:
+    static constexpr int maxSizes = 4;
+
+    FilmStrip(const juce::Image& strip, int numFrames);
+
+    bool isValid() const noexcept { return source.isValid(); }
+    int  getNumFrames() const noexcept { return numFrames; }
+    juce::Rectangle<int> getFrameBounds() const noexcept { return { frameW, frameH }; }
+
+    /* which frame shows `proportion` (0 … 1) of the way along */
+    static int frameFor(float proportion, int numFrames) noexcept;
+
+    /* frame stretched over area */
+    void draw(juce::Graphics& g, juce::Rectangle<int> area, int frame) const;
+
+private:
+    struct Scaled
+    {
+        int width = 0, height = 0;              // physical pixels
+        std::vector<juce::Image> frames;        // invalid until first drawn
+        juce::uint32 lastUsed = 0;
+    };
+
+    const juce::Image& getScaled(int width, int height, int frame) const;
+
+    juce::Image source;
+    int numFrames = 1, frameW = 0, frameH = 0;
+
+    mutable std::vector<Scaled> sizes;
+    mutable juce::uint32 useCounter = 0;
+};
+
+//==============================================================================
+/*  A rotary slider drawn from a film strip, which repaints only when the
+    frame it shows changes. juce::Slider asks for a repaint on every value
+    change – a host automating the parameter, a preset gliding in – and
+    most of those land on the same frame; this drops them before they
+    reach the parent, so neither the knob nor the editor behind it paints
+    again for nothing.                                                   */
+class FilmStripKnob : public juce::Slider
+{
+public:
+    explicit FilmStripKnob(int numFrames);
+    ~FilmStripKnob() override;
+
+    int getCurrentFrame() const noexcept;
+
+    // what a frame can't tell: these always repaint
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
+    void lookAndFeelChanged() override;
+    void enablementChanged() override;
+
+private:
+    class RepaintGate;
+
+    void repaintAnyway();
+
+    const int numFrames;
+    RepaintGate* gate = nullptr;                // owned by the component
+};
@@ -0,0 +1,231 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "BlockSmoother.h"
+
+/*  Single-sweep mix stage for the end of the chain.
+
+    bloomPass   dry ← dry + b·(colour − dry), copy it to the reverb send,
+                and apply the output gain too when the reverb is idle
+    bloomPassMidSide
+                the same for a stereo pair whose colour is mid / side,
+                decoding it back to L/R on the way
+    wetPass     dry ← (dry + w·(wet − dry)) · g
+    bypassFadePass
+                wetPass while bypass fades in or out
+
+    So a block touches each channel twice (once around the reverb) rather
+    than copy / crossfade / copy / crossfade / gain. Every gain is either a
+    rendered per-sample ramp or a constant; the loops are instantiated for
+    each combination so they stay branch-free and auto-vectorise.       */
+template <typename SampleType>
+class FusedMixer
+{
+public:
+    struct Ramp
+    {
+        const SampleType* values = nullptr;    // null → constant
+        SampleType        constant = 1;
+    };
+
+    static Ramp rampOf(const BlockSmoother<SampleType>& s) noexcept
+    {
+        return s.isRamping() ? Ramp{ s.getRamp(), 0 } : Ramp{ nullptr, s.getCurrentValue() };
+    }
+
+    static Ramp constant(SampleType v) noexcept { return { nullptr, v }; }
+
+    void prepare(int maxBlockSize)
+    {
+        gainRamp.allocate((size_t)juce::jmax(1, maxBlockSize), true);
+        dryRamp.allocate((size_t)juce::jmax(1, maxBlockSize), true);
+        productRamp.allocate((size_t)juce::jmax(1, maxBlockSize), true);
+        capacity = dryCapacity = productCapacity = juce::jmax(1, maxBlockSize);
+    }
+
+    /* linear from → to over numSamples, like AudioBuffer::applyGainRamp */
+    Ramp makeGainRamp(SampleType from, SampleType to, int numSamples) noexcept
+    {
+        if (juce::approximatelyEqual(from, to) || numSamples <= 0)
+            return constant(to);
+
+        // the engine chunks to the prepared size; past it, jump rather
+        // than allocate on the audio thread
+        jassert(numSamples <= capacity);
+
+        if (numSamples > capacity)
+            return constant(to);
+
+        const SampleType step = (to - from) / (SampleType)numSamples;
+        for (int i = 0; i < numSamples; ++i)
+            gainRamp[i] = from + step * (SampleType)i;
+
+        return { gainRamp.get(), 0 };
+    }
+
+    /* (1 − mix)·gain – what wetPass leaves of the dry signal when the wet
+       input is silent, so a sleeping reverb folds into bloomPass        */
+    Ramp makeDryGain(Ramp mix, Ramp gain, int numSamples) noexcept
+    {
+        if (mix.values == nullptr && gain.values == nullptr)
+            return constant((1 - mix.constant) * gain.constant);
+
+        // as above: never allocate here. Ramps this long can't have been
+        // made (they came back constant), so only the constants are left
+        jassert(numSamples <= dryCapacity);
+
+        if (numSamples > dryCapacity)
+            return constant((1 - mix.constant) * gain.constant);
+
+        SampleType* out = dryRamp.get();
+        dispatch(mix, [&](auto w) { dispatch(gain, [&](auto g)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                out[i] = (1 - w[i]) * g[i];
+        }); });
+
+        return { out, 0 };
+    }
+
+    /* a·b – the Bloom ramp scaled down while bypass fades in or out */
+    Ramp makeProduct(Ramp a, Ramp b, int numSamples) noexcept
+    {
+        if (a.values == nullptr && b.values == nullptr)
+            return constant(a.constant * b.constant);
+
+        // never allocate here either; this long, jump to where it ends
+        jassert(numSamples <= productCapacity);
+
+        if (numSamples > productCapacity)
+        {
+            const auto last = [numSamples](Ramp r)
+            {
+                return r.values != nullptr ? r.values[numSamples - 1] : r.constant;
+            };
+            return constant(last(a) * last(b));
+        }
+
+        SampleType* out = productRamp.get();
+        dispatch(a, [&](auto x) { dispatch(b, [&](auto y)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                out[i] = x[i] * y[i];
+        }); });
+
+        return { out, 0 };
+    }
+
+    //==========================================================================
+    /* send may be null (reverb idle) */
+    static void bloomPass(SampleType* dry, const SampleType* col, SampleType* send,
+                          Ramp bloom, Ramp gain, int numSamples) noexcept
+    {
+        dispatch(bloom, [&](auto b) { dispatch(gain, [&](auto g)
+        {
+            if (send != nullptr)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const SampleType d = dry[i];
+                    const SampleType m = d + b[i] * (col[i] - d);
+                    send[i] = m;
+                    dry[i] = m * g[i];
+                }
+            }
+            else
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const SampleType d = dry[i];
+                    dry[i] = (d + b[i] * (col[i] - d)) * g[i];
+                }
+            }
+        }); });
+    }
+
+    /* colour is M = (L + R)/2, S = (L − R)/2. side weights the Bloom:
+       0 mid only, 0.5 both in full, 1 side only. sendL/R may be null   */
+    static void bloomPassMidSide(SampleType* dryL, SampleType* dryR,
+                                 const SampleType* colM, const SampleType* colS,
+                                 SampleType* sendL, SampleType* sendR,
+                                 Ramp bloom, Ramp side, Ramp gain, int numSamples) noexcept
+    {
+        dispatch(bloom, [&](auto b) { dispatch(side, [&](auto s) { dispatch(gain, [&](auto g)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const SampleType l = dryL[i], r = dryR[i];
+                const SampleType bm = b[i] * juce::jmin(SampleType(1), 2 * (1 - s[i]));
+                const SampleType bs = b[i] * juce::jmin(SampleType(1), 2 * s[i]);
+                const SampleType dm = bm * (colM[i] - (l + r) * SampleType(0.5));
+                const SampleType ds = bs * (colS[i] - (l - r) * SampleType(0.5));
+                const SampleType ml = l + dm + ds;
+                const SampleType mr = r + dm - ds;
+
+                if (sendL != nullptr)
+                {
+                    sendL[i] = ml;
+                    sendR[i] = mr;
+                }
+
+                dryL[i] = ml * g[i];
+                dryR[i] = mr * g[i];
+            }
+        }); }); });
+    }
+
+    static void wetPass(SampleType* dry, const SampleType* wet,
+                        Ramp mix, Ramp gain, int numSamples) noexcept
+    {
+        dispatch(mix, [&](auto w) { dispatch(gain, [&](auto g)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const SampleType d = dry[i];
+                dry[i] = (d + w[i] * (wet[i] - d)) * g[i];
+            }
+        }); });
+    }
+
+    /* p is how much of the processed mix is left (1 → 0 going into
+       bypass). Bypassed, the dry signal passes untouched and the reverb
+       tail keeps ringing at w·g, so only the dry level moves:
+       dry ← dry·(p·(1 − w)·g + 1 − p) + wet·w·g. wet may be null (reverb
+       idle); the Bloom mix before it must have been left at unity gain */
+    static void bypassFadePass(SampleType* dry, const SampleType* wet,
+                               Ramp processed, Ramp mix, Ramp gain, int numSamples) noexcept
+    {
+        dispatch(processed, [&](auto p) { dispatch(mix, [&](auto w) { dispatch(gain, [&](auto g)
+        {
+            if (wet != nullptr)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const SampleType wg = w[i] * g[i];
+                    dry[i] = dry[i] * (p[i] * (g[i] - wg) + 1 - p[i]) + wet[i] * wg;
+                }
+            }
+            else
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    dry[i] *= p[i] * (1 - w[i]) * g[i] + 1 - p[i];
+            }
+        }); }); });
+    }
+
+private:
+    struct Constant
+    {
+        SampleType v;
+        SampleType operator[](int) const noexcept { return v; }
+    };
+
+    template <typename Fn>
+    static void dispatch(Ramp r, Fn&& fn) noexcept
+    {
+        if (r.values != nullptr)  fn(r.values);
+        else                      fn(Constant{ r.constant });
+    }
+
+    juce::HeapBlock<SampleType> gainRamp, dryRamp, productRamp;
+    int capacity = 0, dryCapacity = 0, productCapacity = 0;
+};
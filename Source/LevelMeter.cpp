@@ -0,0 +1,94 @@
+#include "LevelMeter.h"
+
+namespace
+{
+    constexpr int peakLine = 2;     // px
+    constexpr int barGap = 2;
+}
+
+//===========================================================================
+int LevelMeter::toPixels(float gain) const noexcept
+{
+    const float db = juce::Decibels::gainToDecibels(gain, minDb);
+    return juce::roundToInt(juce::jlimit(0.0f, 1.0f, (db - minDb) / (maxDb - minDb))
+                            * (float)getHeight());
+}
+
+juce::Rectangle<int> LevelMeter::barBounds(int bar) const
+{
+    const int w = (getWidth() - barGap * (MeterFeed::numMeters - 1)) / MeterFeed::numMeters;
+    return { bar * (w + barGap), 0, w, getHeight() };
+}
+
+void LevelMeter::setLevels(const MeterFeed::Levels& levels)
+{
+    const int h = getHeight();
+
+    for (int i = 0; i < MeterFeed::numMeters; ++i)
+    {
+        const Bar next{ toPixels(levels.peak[i]), toPixels(levels.rms[i]) };
+        auto& bar = bars[(size_t)i];
+
+        if (next.peakPx == bar.peakPx && next.rmsPx == bar.rmsPx)
+            continue;
+
+        // only the span that changed, peak line included
+        const int top = juce::jmax(next.peakPx, bar.peakPx, next.rmsPx, bar.rmsPx) + peakLine;
+        const int bottom = juce::jmin(next.peakPx, bar.peakPx, next.rmsPx, bar.rmsPx);
+        bar = next;
+
+        const auto r = barBounds(i);
+        repaint(r.getX(), h - top, r.getWidth(), top - bottom);
+    }
+}
+
+void LevelMeter::paint(juce::Graphics& g)
+{
+    const int h = getHeight();
+    const int zeroPx = toPixels(1.0f);
+
+    for (int i = 0; i < MeterFeed::numMeters; ++i)
+    {
+        const auto r = barBounds(i);
+        const auto& bar = bars[(size_t)i];
+
+        if (!g.clipRegionIntersects(r))
+            continue;
+
+        g.setColour(juce::Colours::black.withAlpha(0.35f));
+        g.fillRect(r);
+
+        g.setColour(juce::Colours::white.withAlpha(0.55f));
+        g.fillRect(r.withTop(h - bar.rmsPx));
+
+        if (bar.peakPx > 0)
+        {
+            g.setColour(bar.peakPx > zeroPx ? juce::Colours::red : juce::Colours::white);
+            g.fillRect(r.getX(), h - bar.peakPx, r.getWidth(), peakLine);
+        }
+    }
+}
+
+//===========================================================================
+void ReductionMeter::setReductionDb(float db)
+{
+    const int w = getWidth();
+    const int px = juce::roundToInt(juce::jlimit(0.0f, 1.0f, -db / rangeDb) * (float)w);
+
+    if (px == reductionPx)
+        return;
+
+    repaint(w - juce::jmax(px, reductionPx), 0, std::abs(px - reductionPx), getHeight());
+    reductionPx = px;
+}
+
+void ReductionMeter::paint(juce::Graphics& g)
+{
+    const auto r = getLocalBounds();
+
+    g.setColour(juce::Colours::black.withAlpha(0.35f));
+    g.fillRect(r);
+
+    g.setColour(juce::Colours::orange.withAlpha(0.8f));
+    g.fillRect(r.withLeft(r.getRight() - reductionPx));
+}
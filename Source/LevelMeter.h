@@ -0,0 +1,42 @@
+#pragma once
+#include <JuceHeader.h>
+#include "MeterFeed.h"
+
+/*  Meter bars for the editor, fed from MeterFeed on the editor's timer.
+
+    Setting a level only repaints the strip between where a bar was and
+    where it is now, and nothing at all when it hasn't moved by a pixel –
+    so steady or silent meters cost no painting.                        */
+class LevelMeter : public juce::Component
+{
+public:
+    static constexpr float minDb = -60.0f;
+    static constexpr float maxDb = 6.0f;
+
+    /* one bar per meter: RMS filled, peak as a line (red over 0 dBFS) */
+    void setLevels(const MeterFeed::Levels& levels);
+
+    void paint(juce::Graphics&) override;
+
+private:
+    struct Bar { int peakPx = 0, rmsPx = 0; };
+
+    juce::Rectangle<int> barBounds(int bar) const;
+    int toPixels(float gain) const noexcept;
+
+    std::array<Bar, MeterFeed::numMeters> bars;
+};
+
+/*  Gain reduction, 0 … −rangeDb, as a bar growing in from the right    */
+class ReductionMeter : public juce::Component
+{
+public:
+    static constexpr float rangeDb = 12.0f;
+
+    void setReductionDb(float db);
+
+    void paint(juce::Graphics&) override;
+
+private:
+    int reductionPx = 0;
+};
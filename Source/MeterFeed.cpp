@@ -0,0 +1,151 @@
+#include "MeterFeed.h"
+
+//===========================================================================
+// editor side
+int MeterFeed::popFrames(Frame* dest, int maxToRead) noexcept
+{
+    int start1, size1, start2, size2;
+    frameFifo.prepareToRead(juce::jmin(maxToRead, frameFifo.getNumReady()), start1, size1, start2, size2);
+
+    std::copy_n(frames.begin() + start1, size1, dest);
+    std::copy_n(frames.begin() + start2, size2, dest + size1);
+
+    frameFifo.finishedRead(size1 + size2);
+    return size1 + size2;
+}
+
+// frames go in whole and come out whole, so the reader stays aligned
+bool MeterFeed::popAnalysisFrame(float* dest) noexcept
+{
+    if (analysisFifo.getNumReady() < analysisFrameSize)
+        return false;
+
+    int start1, size1, start2, size2;
+    analysisFifo.prepareToRead(analysisFrameSize, start1, size1, start2, size2);
+
+    std::copy_n(analysis.begin() + start1, size1, dest);
+    std::copy_n(analysis.begin() + start2, size2, dest + size1);
+
+    analysisFifo.finishedRead(size1 + size2);
+    return true;
+}
+
+//===========================================================================
+// audio thread
+void MeterFeed::prepare(double sampleRate) noexcept
+{
+    // a frame that was half written when audio stopped carries on with
+    // the new audio – dropping it would leave the reader misaligned
+    hopSamples = juce::jmax(analysisFrameSize, juce::roundToInt(sampleRate / framesPerSecond));
+}
+
+void MeterFeed::push(const Frame& frame) noexcept
+{
+    int start1, size1, start2, size2;
+    frameFifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 > 0)
+        frames[(size_t)start1] = frame;
+
+    frameFifo.finishedWrite(size1);       // 0 if full: the frame is dropped
+}
+
+template <typename SampleType>
+void MeterFeed::pushAnalysis(const juce::AudioBuffer<SampleType>& buffer, int numChannels) noexcept
+{
+    const int numCh = juce::jmin(numChannels, buffer.getNumChannels());
+    const int numSmp = buffer.getNumSamples();
+
+    if (numCh <= 0)
+        return;
+
+    const float scale = 1.0f / (float)numCh;
+
+    auto writeMono = [&](int pos, int n)
+    {
+        int start1, size1, start2, size2;
+        analysisFifo.prepareToWrite(n, start1, size1, start2, size2);
+
+        for (auto [start, size] : { std::pair{ start1, size1 }, std::pair{ start2, size2 } })
+        {
+            float* d = analysis.data() + start;
+
+            for (int i = 0; i < size; ++i)
+            {
+                SampleType sum = 0;
+                for (int ch = 0; ch < numCh; ++ch)
+                    sum += buffer.getReadPointer(ch)[pos + i];
+
+                d[i] = (float)sum * scale;
+            }
+
+            pos += size;
+        }
+
+        analysisFifo.finishedWrite(size1 + size2);
+    };
+
+    for (int pos = 0; pos < numSmp;)
+    {
+        if (framePos < 0)
+        {
+            // between frames: wait for the next start, then begin one only
+            // if the analyser wants it and all of it will fit
+            const int skip = juce::jmin(untilNextFrame, numSmp - pos);
+            untilNextFrame -= skip;
+            pos += skip;
+
+            if (untilNextFrame > 0)
+                return;
+
+            untilNextFrame = hopSamples;
+
+            if (!analysisWanted.load() || analysisFifo.getFreeSpace() < analysisFrameSize)
+                continue;
+
+            framePos = 0;
+        }
+
+        const int n = juce::jmin(analysisFrameSize - framePos, numSmp - pos);
+        writeMono(pos, n);
+
+        untilNextFrame -= n;
+        framePos += n;
+        pos += n;
+
+        if (framePos == analysisFrameSize)
+            framePos = -1;
+    }
+}
+
+template <typename SampleType>
+MeterFeed::Levels MeterFeed::measure(const juce::AudioBuffer<SampleType>& buffer, int numChannels) noexcept
+{
+    Levels l;
+    const int numCh = juce::jmin(numChannels, buffer.getNumChannels(), numMeters);
+    const int numSmp = buffer.getNumSamples();
+
+    if (numCh <= 0 || numSmp <= 0)
+        return l;
+
+    for (int m = 0; m < numMeters; ++m)
+    {
+        if (m < numCh)
+        {
+            l.peak[m] = (float)buffer.getMagnitude(m, 0, numSmp);
+            l.rms[m] = (float)buffer.getRMSLevel(m, 0, numSmp);
+        }
+        else
+        {
+            l.peak[m] = l.peak[m - 1];          // mono: the same on both
+            l.rms[m] = l.rms[m - 1];
+        }
+    }
+
+    return l;
+}
+
+template void MeterFeed::pushAnalysis(const juce::AudioBuffer<float>&, int) noexcept;
+template void MeterFeed::pushAnalysis(const juce::AudioBuffer<double>&, int) noexcept;
+template MeterFeed::Levels MeterFeed::measure(const juce::AudioBuffer<float>&, int) noexcept;
+template MeterFeed::Levels MeterFeed::measure(const juce::AudioBuffer<double>&, int) noexcept;
@@ -0,0 +1,86 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <atomic>
+
+/*  Audio thread → editor: input / output levels, the Bloom clip's gain
+    reduction, and output audio for the analyser.
+
+    Two single-producer / single-consumer FIFOs (juce::AbstractFifo):
+    one Frame per processBlock() for the meters, and mono analysis
+    frames of analysisFrameSize samples. The push side never blocks or
+    allocates – if the editor falls behind, frames are dropped. Nothing
+    is measured or pushed unless an editor has said it's reading
+    (setConsumerActive), and analysis audio only while it wants it.
+
+    Analysis frames are decimated in time, not in frequency: each one is
+    analysisFrameSize consecutive samples, and a new one starts at most
+    framesPerSecond times a second – back to back at 44.1 / 48 kHz,
+    with gaps between them at higher rates.                              */
+class MeterFeed
+{
+public:
+    static constexpr int numMeters = 2;            // L / R; mono shows on both, beds their front pair
+    static constexpr int analysisFrameSize = 2048;
+    static constexpr int framesPerSecond = 30;
+
+    struct Levels
+    {
+        float peak[numMeters] = {};                // linear
+        float rms[numMeters] = {};
+    };
+
+    struct Frame
+    {
+        Levels in, out;
+        float  clipReductionDb = 0.0f;             // ≤ 0
+        int    numSamples = 0;
+    };
+
+    MeterFeed() = default;
+
+    //==========================================================================
+    // editor (consumer) side
+    void setConsumerActive(bool active) noexcept  { consumerActive = active; }
+    bool isConsumerActive() const noexcept        { return consumerActive.load(); }
+
+    /* oldest first; returns how many were copied */
+    int popFrames(Frame* dest, int maxFrames) noexcept;
+
+    void setAnalysisWanted(bool wanted) noexcept  { analysisWanted = wanted; }
+
+    /* one whole frame of analysisFrameSize samples, or false if none is ready */
+    bool popAnalysisFrame(float* dest) noexcept;
+
+    //==========================================================================
+    // audio thread (producer) side
+    void prepare(double sampleRate) noexcept;
+
+    void push(const Frame& frame) noexcept;
+
+    /* mono sum of the first numChannels channels, if the analyser wants it */
+    template <typename SampleType>
+    void pushAnalysis(const juce::AudioBuffer<SampleType>& buffer, int numChannels) noexcept;
+
+    /* peak / RMS of the first numChannels channels */
+    template <typename SampleType>
+    static Levels measure(const juce::AudioBuffer<SampleType>& buffer, int numChannels) noexcept;
+
+private:
+    static constexpr int maxFrames = 128;
+
+    juce::AbstractFifo          frameFifo{ maxFrames };
+    std::array<Frame, maxFrames> frames;
+
+    juce::AbstractFifo analysisFifo{ 4 * analysisFrameSize };
+    std::array<float, 4 * analysisFrameSize> analysis{};
+
+    std::atomic<bool> consumerActive{ false }, analysisWanted{ false };
+
+    // audio thread only
+    int hopSamples = analysisFrameSize;            // frame start to frame start
+    int untilNextFrame = 0;
+    int framePos = -1;                             // inside a frame, or −1 between them
+
+    JUCE_DECLARE_NON_COPYABLE(MeterFeed)
+};
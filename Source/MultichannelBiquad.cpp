@@ -0,0 +1,95 @@
+#include "MultichannelBiquad.h"
+
+//===========================================================================
+template <typename SampleType>
+void MultichannelBiquad<SampleType>::prepare(const juce::dsp::ProcessSpec& spec) noexcept
+{
+    jassert((int)spec.numChannels <= maxChannels);
+    numChannels = juce::jmin((int)spec.numChannels, maxChannels);
+    reset();
+}
+
+template <typename SampleType>
+void MultichannelBiquad<SampleType>::reset() noexcept
+{
+    s1.fill(0);
+    s2.fill(0);
+}
+
+template <typename SampleType>
+void MultichannelBiquad<SampleType>::setCoefficients(
+    const juce::dsp::IIR::Coefficients<SampleType>& c) noexcept
+{
+    jassert(c.coefficients.size() == numCoeffs);   // second order only
+    std::copy_n(c.coefficients.begin(), numCoeffs, coeffs.begin());
+}
+
+//===========================================================================
+// audio thread
+template <typename SampleType>
+void MultichannelBiquad<SampleType>::process(
+    const juce::dsp::ProcessContextReplacing<SampleType>& ctx) noexcept
+{
+    auto& block = ctx.getOutputBlock();
+    const int numCh = juce::jmin((int)block.getNumChannels(), numChannels);
+    const int numSmp = (int)block.getNumSamples();
+
+    if (ctx.isBypassed || numSmp == 0)
+        return;
+
+    for (int first = 0, group = 0; first < numCh; first += lanes, ++group)
+    {
+        const int numLanes = juce::jmin(lanes, numCh - first);
+
+        SampleType* chans[lanes] = {};
+        for (int k = 0; k < numLanes; ++k)
+            chans[k] = block.getChannelPointer((size_t)(first + k));
+
+        processGroup(chans, numLanes, group, numSmp);
+    }
+}
+
+// one vector step per sample: gather a sample from each channel of the
+// group, run the biquad on all lanes at once, scatter the results back
+template <typename SampleType>
+void MultichannelBiquad<SampleType>::processGroup(SampleType* const* chans, int numLanes,
+                                                  int group, int numSamples) noexcept
+{
+    const Vec b0 = Vec::expand(coeffs[0]), b1 = Vec::expand(coeffs[1]), b2 = Vec::expand(coeffs[2]);
+    const Vec a1 = Vec::expand(coeffs[3]), a2 = Vec::expand(coeffs[4]);
+
+    SampleType* const z1 = s1.data() + group * lanes;
+    SampleType* const z2 = s2.data() + group * lanes;
+    Vec v1 = Vec::fromRawArray(z1), v2 = Vec::fromRawArray(z2);
+
+    alignas(32) SampleType frame[lanes] = {};
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int k = 0; k < numLanes; ++k)
+            frame[k] = chans[k][i];
+
+        const Vec x = Vec::fromRawArray(frame);
+        const Vec y = b0 * x + v1;
+        v1 = b1 * x - a1 * y + v2;
+        v2 = b2 * x - a2 * y;
+
+        y.copyToRawArray(frame);
+
+        for (int k = 0; k < numLanes; ++k)
+            chans[k][i] = frame[k];
+    }
+
+    v1.copyToRawArray(z1);
+    v2.copyToRawArray(z2);
+
+    // like IIR::Filter, keep denormals out of the state between blocks
+    for (int k = 0; k < lanes; ++k)
+    {
+        juce::dsp::util::snapToZero(z1[k]);
+        juce::dsp::util::snapToZero(z2[k]);
+    }
+}
+
+template class MultichannelBiquad<float>;
+template class MultichannelBiquad<double>;
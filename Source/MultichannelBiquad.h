@@ -0,0 +1,44 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+
+/*  One biquad for every channel of a bed, run channel-parallel.
+
+    ProcessorDuplicator runs a scalar filter per channel, one after the
+    other, and each sample waits on the one before it. Here the channels
+    are split into groups of SIMDRegister width (4 floats / 2 doubles on
+    SSE and NEON) and a group steps through the block together, one lane
+    per channel – so 5.1 is two float groups, 7.1.4 three. A short last
+    group is padded with silent lanes.
+
+    Transposed direct form II, the same coefficients on every channel,
+    laid out like juce::dsp::IIR::Coefficients (b0 b1 b2 a1 a2,
+    normalised by a0), so getRawCoefficients() can be written in place.
+    No allocation: state is sized for maxChannels up front.              */
+template <typename SampleType>
+class MultichannelBiquad
+{
+public:
+    static constexpr int maxChannels = 16;       // 9.1.6
+    static constexpr int numCoeffs = 5;
+
+    void prepare(const juce::dsp::ProcessSpec& spec) noexcept;
+    void reset() noexcept;
+
+    void setCoefficients(const juce::dsp::IIR::Coefficients<SampleType>& c) noexcept;
+    SampleType* getRawCoefficients() noexcept { return coeffs.data(); }
+
+    /* channels past maxChannels are left untouched */
+    void process(const juce::dsp::ProcessContextReplacing<SampleType>& ctx) noexcept;
+
+private:
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr int lanes = (int)Vec::SIMDNumElements;
+    static constexpr int maxGroups = (maxChannels + lanes - 1) / lanes;
+
+    void processGroup(SampleType* const* chans, int numLanes, int group, int numSamples) noexcept;
+
+    std::array<SampleType, numCoeffs> coeffs{ 1, 0, 0, 0, 0 };
+    alignas(32) std::array<SampleType, (size_t)(maxGroups * lanes)> s1{}, s2{};
+    int numChannels = 0;
+};
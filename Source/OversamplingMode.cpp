@@ -0,0 +1,154 @@
+#include "OversamplingMode.h"
+#include "ColourPath.h"
+
+//===========================================================================
+juce::StringArray OversamplingMode::getFactorNames()
+{
+    return { juce::String::fromUTF8(u8"1×"),
+             juce::String::fromUTF8(u8"2×"),
+             juce::String::fromUTF8(u8"4×"),
+             juce::String::fromUTF8(u8"8× (render)"),
+             juce::String::fromUTF8(u8"16× (render)") };
+}
+
+juce::StringArray OversamplingMode::getFilterNames()
+{
+    return { "Standard", "Linear Phase", "Low Latency" };
+}
+
+OversamplingMode OversamplingMode::resolvedFor(bool isNonRealtime) const noexcept
+{
+    auto m = *this;
+    m.factorChoice = juce::jlimit(0, numFactors - 1, m.factorChoice);
+
+    if (!isNonRealtime)
+        m.factorChoice = juce::jmin(m.factorChoice, maxRealtimeFactorChoice);
+
+    return m;
+}
+
+//===========================================================================
+template <typename SampleType>
+std::unique_ptr<juce::dsp::Oversampling<SampleType>>
+OversamplingMode::createOversampler(size_t numChannels) const
+{
+    if (factorChoice <= 0)
+        return {};
+
+    using OS = juce::dsp::Oversampling<SampleType>;
+
+    const auto type = (filter == linearPhase) ? OS::FilterType::filterHalfBandFIREquiripple
+                                              : OS::FilterType::filterHalfBandPolyphaseIIR;
+    const bool maxQuality = (filter != lowLatency);
+
+    // factor is passed as a power of two; integer latency so the dry
+    // path can be delayed to match exactly
+    return std::make_unique<OS>(numChannels, (size_t)factorChoice, type,
+                                maxQuality, /*useIntegerLatency*/ true);
+}
+
+template std::unique_ptr<juce::dsp::Oversampling<float>>  OversamplingMode::createOversampler<float>(size_t) const;
+template std::unique_ptr<juce::dsp::Oversampling<double>> OversamplingMode::createOversampler<double>(size_t) const;
+
+//===========================================================================
+namespace
+{
+    // seconds per block of a prepared float ColourPath for `mode`, stereo
+    // 48 kHz, 512-sample blocks – the best of a few short rounds, so a
+    // preempted round doesn't count
+    double timeColourStage(OversamplingMode mode)
+    {
+        constexpr int blockSize = 512, blocksPerRound = 8, numRounds = 4;
+
+        ColourPath<float> path(mode);
+        path.prepare({ 48000.0, (juce::uint32)blockSize, 2 }, 12.0f, 12.0f, 0.5f);
+
+        juce::AudioBuffer<float> colour(2, blockSize), dry(2, blockSize);
+        juce::Random r(1);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < blockSize; ++i)
+                dry.setSample(ch, i, (r.nextFloat() * 2.0f - 1.0f) * 0.5f);
+
+        auto run = [&]
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                colour.copyFrom(ch, 0, dry, ch, 0, blockSize);
+
+            path.process(juce::dsp::AudioBlock<float>(colour), juce::dsp::AudioBlock<float>(dry));
+        };
+
+        run();                                  // warm up
+        double best = std::numeric_limits<double>::max();
+
+        for (int round = 0; round < numRounds; ++round)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+
+            for (int b = 0; b < blocksPerRound; ++b)
+                run();
+
+            const auto ticks = juce::Time::getHighResolutionTicks() - start;
+            best = juce::jmin(best, juce::Time::highResolutionTicksToSeconds(ticks) / blocksPerRound);
+        }
+
+        return juce::jmax(best, 1.0e-9);
+    }
+}
+
+//===========================================================================
+OversamplingCosts::OversamplingCosts() : juce::Thread("AirBloom oversampling cost")
+{
+    startThread();
+}
+
+OversamplingCosts::~OversamplingCosts()
+{
+    stopThread(4000);
+}
+
+// realtime factors first: those are what the boxes offer during playback
+void OversamplingCosts::run()
+{
+    const double baseSeconds = timeColourStage({});     // 1×, what relativeCpu is relative to
+
+    for (int ti = 0; ti < numFilters; ++ti)
+        relativeCpu[0][ti] = 1.0f;                      // no oversampler at 1×
+
+    for (const bool offline : { false, true })
+        for (int fi = 1; fi < numFactors; ++fi)
+            for (int ti = 0; ti < numFilters; ++ti)
+            {
+                const OversamplingMode m{ fi, (OversamplingMode::Filter)ti };
+
+                if (m.isOfflineOnly() != offline)
+                    continue;
+
+                if (threadShouldExit())
+                    return;
+
+                relativeCpu[fi][ti] = (float)(timeColourStage(m) / baseSeconds);
+            }
+}
+
+OversamplingMode::Cost OversamplingCosts::get(OversamplingMode mode)
+{
+    const int fi = juce::jlimit(0, numFactors - 1, mode.factorChoice);
+    const int ti = juce::jlimit(0, numFilters - 1, (int)mode.filter);
+
+    if (!latencyKnown[fi][ti])
+    {
+        if (auto os = OversamplingMode{ fi, (OversamplingMode::Filter)ti }.createOversampler<float>(1))
+        {
+            os->initProcessing(64);
+            latencySamples[fi][ti] = juce::roundToInt(os->getLatencyInSamples());
+        }
+
+        latencyKnown[fi][ti] = true;
+    }
+
+    OversamplingMode::Cost c;
+    c.relativeCpu = relativeCpu[fi][ti].load();
+    c.latencySamples = latencySamples[fi][ti];
+    return c;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+
+/*  Oversampling quality for the colour stage:
+    "oversample" (factor) × "osFilter" (filter type).
+
+      Standard      half-band polyphase IIR, max quality (minimum phase)
+      Linear Phase  half-band FIR equiripple – for mastering
+      Low Latency   half-band polyphase IIR, relaxed – for tracking
+
+    8× and 16× are offline-render factors: while the host plays in real
+    time they run at 4×, and switch up when it renders non-realtime.    */
+struct OversamplingMode
+{
+    enum Filter { standard = 0, linearPhase, lowLatency };
+
+    static constexpr int numFactors = 5;              // 1× 2× 4× 8× 16×
+    static constexpr int numFilters = 3;
+    static constexpr int maxRealtimeFactorChoice = 2; // 4×
+
+    int    factorChoice = 0;    // "oversample" index, factor = 1 << factorChoice
+    Filter filter = standard;   // "osFilter" index
+
+    static juce::StringArray getFactorNames();
+    static juce::StringArray getFilterNames();
+
+    int  getFactor() const noexcept { return 1 << factorChoice; }
+    bool isOfflineOnly() const noexcept { return factorChoice > maxRealtimeFactorChoice; }
+
+    OversamplingMode resolvedFor(bool isNonRealtime) const noexcept;
+
+    bool operator== (const OversamplingMode& o) const noexcept
+    {
+        return factorChoice == o.factorChoice && filter == o.filter;
+    }
+    bool operator!= (const OversamplingMode& o) const noexcept { return !operator== (o); }
+
+    /* null at 1×; float and double are instantiated */
+    template <typename SampleType>
+    std::unique_ptr<juce::dsp::Oversampling<SampleType>> createOversampler(size_t numChannels) const;
+
+    //==========================================================================
+    struct Cost
+    {
+        float relativeCpu = 0.0f;   // colour stage, 1× = 1.0; 0 while still being measured
+        int   latencySamples = 0;   // at the host rate
+
+        bool isCpuMeasured() const noexcept { return relativeCpu > 0.0f; }
+    };
+};
+
+//===========================================================================
+/*  What each oversampling mode costs, for the editor's hover text.
+
+    Latency comes from a throw-away Oversampling, made the first time a
+    mode is asked for and cached. CPU is timed once, on a background
+    thread started with the table: a throw-away ColourPath per mode on a
+    few short stereo blocks against the same at 1×, realtime modes first.
+    Nothing is timed on the message thread; until a mode's figure is in,
+    get() hands back a Cost whose CPU isn't measured yet.
+
+    Hold it through a juce::SharedResourcePointer<OversamplingCosts>:
+    every instance in the process shares one table, measured once.      */
+class OversamplingCosts : private juce::Thread
+{
+public:
+    OversamplingCosts();
+    ~OversamplingCosts() override;
+
+    /* message thread; never waits for the measurement */
+    OversamplingMode::Cost get(OversamplingMode mode);
+
+private:
+    void run() override;
+
+    static constexpr int numFactors = OversamplingMode::numFactors;
+    static constexpr int numFilters = OversamplingMode::numFilters;
+
+    std::atomic<float> relativeCpu[numFactors][numFilters] {};   // written by run()
+    int latencySamples[numFactors][numFilters] = {};             // message thread
+    bool latencyKnown[numFactors][numFilters] = {};
+
+    JUCE_DECLARE_NON_COPYABLE(OversamplingCosts)
+};
@@ -1,10 +1,9 @@
 ﻿#include "PluginEditor.h"
 #include "PluginProcessor.h"
 #include "PresetManager.h"
-std::unique_ptr<PresetManager> presetMgr;
 
 AirBloomAudioProcessorEditor::AirBloomAudioProcessorEditor(AirBloomAudioProcessor& p)
-    : AudioProcessorEditor(&p), processorRef(p)
+    : AudioProcessorEditor(&p), processorRef(p), presetMgr(p.getPresetManager())
 {
     // Look & Feel
     lookAndFeel = std::make_unique<AirBloomLookAndFeel>();
@@ -52,15 +51,23 @@ AirBloomAudioProcessorEditor::AirBloomAudioProcessorEditor(AirBloomAudioProcesso
     presetBox.setSelectedId(1);
     addAndMakeVisible(presetBox);
 
-    // ── Oversample selector ───────────────────────────────────
-    oversampleBox.addItem(juce::String::fromUTF8(u8"1×"), 1);
-    oversampleBox.addItem(juce::String::fromUTF8(u8"2×"), 2);
-    oversampleBox.addItem(juce::String::fromUTF8(u8"4×"), 3);
+    // ── Oversample selector (factor × filter) ─────────────────
+    oversampleBox.addItemList(OversamplingMode::getFactorNames(), 1);
     oversampleBox.setSelectedId(1);
     addAndMakeVisible(oversampleBox);
 
+    osFilterBox.addItemList(OversamplingMode::getFilterNames(), 1);
+    osFilterBox.setSelectedId(1);
+    addAndMakeVisible(osFilterBox);
+
     oversampleAttachment = std::make_unique<ChoiceAtt>(
         processorRef.parameters, "oversample", oversampleBox);
+    osFilterAttachment = std::make_unique<ChoiceAtt>(
+        processorRef.parameters, "osFilter", osFilterBox);
+
+    oversampleBox.onChange = [this] { updateOversampleTooltip(); };
+    osFilterBox.onChange = [this] { updateOversampleTooltip(); };
+    updateOversampleTooltip();
 
 
     // Bypass / Oversample / Low-Cut
@@ -121,12 +128,13 @@ AirBloomAudioProcessorEditor::AirBloomAudioProcessorEditor(AirBloomAudioProcesso
     lowCutAttachment = std::make_unique<BtnAtt>(processorRef.parameters,
         "lowCut", lowCutButton);
 
-    presetMgr = std::make_unique<PresetManager>(processorRef.parameters);
-    presetMgr->refreshMenu(presetBox);
+    // the processor's manager; its library is already scanned (or scanning)
+    presetMgr.refreshMenu(presetBox);
+    presetMgr.getLibrary().addChangeListener(this);
 
     presetBox.onChange = [this]
     {
-        presetMgr->handleSelection(presetBox.getText());
+        presetMgr.handleSelection(presetBox.getText());
     };
 
     auto logo = juce::ImageCache::getFromMemory(BinaryData::ASPIRE_AUDIO_png,
@@ -134,6 +142,23 @@ AirBloomAudioProcessorEditor::AirBloomAudioProcessorEditor(AirBloomAudioProcesso
     aspireLogo.setImage(logo, juce::RectanglePlacement::centred);
     addAndMakeVisible(aspireLogo);
 
+#if AIRBLOOM_PROFILE_STAGES
+    addChildComponent(diagnostics);
+    aspireLogo.addMouseListener(this, false);
+#endif
+
+    // ── Meters ────────────────────────────────────────────────
+    addAndMakeVisible(inputMeter);
+    addAndMakeVisible(outputMeter);
+    addAndMakeVisible(clipMeter);
+
+    addAndMakeVisible(spectrumDisplay);
+    spectrumDisplay.toBehind(&bloomSlider);
+    updateShelfCurve();
+
+    processorRef.getMeterFeed().setConsumerActive(true);
+    startTimerHz(30);
+
 #if DEV_PRESET_SAVE
     /* -------------------------------------------------------------- */
     /*  TEMPORARY “save preset” button                                */
@@ -153,8 +178,8 @@ AirBloomAudioProcessorEditor::AirBloomAudioProcessorEditor(AirBloomAudioProcesso
                 auto nm = w.getTextEditor("name")->getText().trim();
                 if (nm.isNotEmpty())
                 {
-                    presetMgr->savePresetAs(nm);
-                    presetMgr->refreshMenu(presetBox);
+                    presetMgr.savePresetAs(nm);
+                    presetMgr.refreshMenu(presetBox);
                     presetBox.setText(nm, juce::dontSendNotification);
                 }
             }
@@ -165,9 +190,140 @@ AirBloomAudioProcessorEditor::AirBloomAudioProcessorEditor(AirBloomAudioProcesso
 }
 AirBloomAudioProcessorEditor::~AirBloomAudioProcessorEditor()
 {
+    stopTimer();
+    presetMgr.getLibrary().removeChangeListener(this);
+    processorRef.getMeterFeed().setConsumerActive(false);
     setLookAndFeel(nullptr);
 }
 
+// drain what the audio thread measured since the last tick: peaks are the
+// loudest of it (falling back slowly), RMS the energy over the tick; the
+// meters repaint only what moved
+void AirBloomAudioProcessorEditor::timerCallback()
+{
+    constexpr float peakRelease = 0.89f;     // ≈ −1 dB per tick, 30 dB/s
+    constexpr float clipReleaseDb = 1.0f;    // per tick
+    constexpr int   numMeters = MeterFeed::numMeters;
+
+    MeterFeed::Frame frames[32];
+    MeterFeed::Levels in, out;
+    double inEnergy[numMeters] = {}, outEnergy[numMeters] = {};
+    double numSamples = 0.0;
+    float  clip = 0.0f;
+
+    for (int n; (n = processorRef.getMeterFeed().popFrames(frames, 32)) > 0;)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            const auto& f = frames[i];
+
+            for (int m = 0; m < numMeters; ++m)
+            {
+                in.peak[m] = juce::jmax(in.peak[m], f.in.peak[m]);
+                out.peak[m] = juce::jmax(out.peak[m], f.out.peak[m]);
+                inEnergy[m] += (double)f.in.rms[m] * f.in.rms[m] * f.numSamples;
+                outEnergy[m] += (double)f.out.rms[m] * f.out.rms[m] * f.numSamples;
+            }
+
+            clip = juce::jmin(clip, f.clipReductionDb);
+            numSamples += f.numSamples;
+        }
+    }
+
+    for (int m = 0; m < numMeters; ++m)
+    {
+        inputShown.peak[m] = juce::jmax(in.peak[m], inputShown.peak[m] * peakRelease);
+        outputShown.peak[m] = juce::jmax(out.peak[m], outputShown.peak[m] * peakRelease);
+
+        // no audio this tick (transport stopped): let the RMS fall too
+        inputShown.rms[m] = numSamples > 0 ? (float)std::sqrt(inEnergy[m] / numSamples)
+                                           : inputShown.rms[m] * peakRelease;
+        outputShown.rms[m] = numSamples > 0 ? (float)std::sqrt(outEnergy[m] / numSamples)
+                                            : outputShown.rms[m] * peakRelease;
+    }
+
+    clipShown = juce::jmin(clip, juce::jmin(0.0f, clipShown + clipReleaseDb));
+
+    inputMeter.setLevels(inputShown);
+    outputMeter.setLevels(outputShown);
+    clipMeter.setReductionDb(clipShown);
+
+    if (const double rate = processorRef.getSampleRate(); rate > 0.0)
+        analyser.setSampleRate(rate);
+
+    if (SpectrumAnalyser::Spectrum spectrum; analyser.getLatest(spectrum))
+        spectrumDisplay.setSpectrum(spectrum);
+
+    updateShelfCurve();
+
+    if (oversampleCostPending)
+        updateOversampleTooltip();
+}
+
+// the shelf's response only changes with Bloom or the rate it runs at
+// (host rate × oversampling), so only then is it worked out again
+void AirBloomAudioProcessorEditor::updateShelfCurve()
+{
+    const float bloom = processorRef.bloomParam->load();
+    const double rate = processorRef.getShelfSampleRate();
+
+    if (bloom == curveBloom && rate == curveRate)
+        return;
+
+    curveBloom = bloom;
+    curveRate = rate;
+
+    constexpr int numPoints = SpectrumAnalyser::numPoints;
+    double freqs[numPoints], mags[numPoints];
+
+    for (int p = 0; p < numPoints; ++p)
+        freqs[p] = SpectrumAnalyser::getPointFrequency(p);
+
+    AirBloomEngineBase::getShelfResponse(rate, bloom, freqs, mags, numPoints);
+
+    SpectrumAnalyser::Spectrum gainDb;
+    for (int p = 0; p < numPoints; ++p)
+        gainDb[(size_t)p] = juce::Decibels::gainToDecibels((float)mags[p]);
+
+    spectrumDisplay.setShelfCurve(gainDb, AirBloomEngineBase::getShelfBoostDb(1.0f));
+}
+
+#if AIRBLOOM_PROFILE_STAGES
+void AirBloomAudioProcessorEditor::mouseDoubleClick(const juce::MouseEvent& e)
+{
+    if (aspireLogo.getBounds().contains(e.getEventRelativeTo(this).getPosition()))
+        diagnostics.setVisible(!diagnostics.isVisible());
+}
+#endif
+
+// presets were added, removed or edited (or the first scan finished)
+void AirBloomAudioProcessorEditor::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    presetMgr.refreshMenu(presetBox);
+}
+
+// hover text on the oversampling boxes: what the current mode costs
+void AirBloomAudioProcessorEditor::updateOversampleTooltip()
+{
+    const auto cost = processorRef.getOversamplingCost(
+        oversampleBox.getSelectedItemIndex(), osFilterBox.getSelectedItemIndex());
+
+    // the CPU figures are timed once in the background; the timer asks
+    // again until this one is in
+    oversampleCostPending = !cost.isCpuMeasured();
+
+    const auto cpu = oversampleCostPending
+                         ? juce::String::fromUTF8(u8"measuring…")
+                         : "~" + juce::String(cost.relativeCpu, 1)
+                               + juce::String::fromUTF8(u8"× (colour stage)");
+
+    const auto tip = "Latency: " + juce::String(cost.latencySamples) + " samples\n"
+                   + "CPU: " + cpu;
+
+    oversampleBox.setTooltip(tip);
+    osFilterBox.setTooltip(tip);
+}
+
 void AirBloomAudioProcessorEditor::paint(juce::Graphics& g)
 {
     if (backgroundImage.isValid())
@@ -189,13 +345,14 @@ void AirBloomAudioProcessorEditor::resized()
     auto full = getLocalBounds().reduced(edgePad);
     auto header = full.removeFromTop(topBarHeight);
 
-    constexpr int presetW = 300;     // slimmer preset menu
+    constexpr int presetW = 220;     // slimmer preset menu
     constexpr int presetH = 40;
     constexpr int overW = 100;     // oversample selector
     constexpr int overH = 40;
+    constexpr int filterW = 100;     // oversample filter type
     constexpr int gapW = 12;
 
-    const int groupW = presetW + gapW + overW;
+    const int groupW = presetW + gapW + overW + gapW + filterW;
     const int groupX = (getWidth() - groupW) / 2;
     const int groupY = header.getCentreY() - presetH / 2 + 8;
 
@@ -208,6 +365,10 @@ void AirBloomAudioProcessorEditor::resized()
         groupY,
         overW, overH);
 
+    osFilterBox.setBounds(oversampleBox.getRight() + gapW,
+        groupY,
+        filterW, overH);
+
     // ── three columns below header ─────────────────────────
     auto panels = full.reduced(0, 40);           // top cushion
     const int colW = (panels.getWidth() - 2 * panelGap) / 3;
@@ -236,6 +397,8 @@ void AirBloomAudioProcessorEditor::resized()
         inputGainSlider.setBounds(centreX(leftCol, 80), y, 80, 80);
         inputGainLabel.setBounds(inputGainSlider.getX(),
             inputGainSlider.getBottom(), 80, 20);
+        inputMeter.setBounds(inputGainSlider.getRight() + 6,
+            inputGainSlider.getY(), 10, 100);
 
         y += 165;
         bypassButton.setBounds(centreX(leftCol, bigBtnW), y,
@@ -250,6 +413,9 @@ void AirBloomAudioProcessorEditor::resized()
         bloomLabel.setBounds(bloomSlider.getX(),
             bloomSlider.getBottom() - 8, // was +0 → +8 px
             180, 20);
+        clipMeter.setBounds(centreX(centreCol, 100),
+            bloomLabel.getBottom() + 1, 100, 4);
+        spectrumDisplay.setBounds(bloomSlider.getBounds().expanded(30, 0));
 
         y += 198;                        // adjust for new gap
         reverbWetSlider.setBounds(centreX(centreCol, 0), y, 80, 80);
@@ -268,6 +434,8 @@ void AirBloomAudioProcessorEditor::resized()
         outputGainSlider.setBounds(centreX(rightCol, 80), y, 80, 80);
         outputGainLabel.setBounds(outputGainSlider.getX(),
             outputGainSlider.getBottom(), 80, 20);
+        outputMeter.setBounds(outputGainSlider.getRight() + 6,
+            outputGainSlider.getY(), 10, 100);
     }
 
     // BOTTOM LOGO
@@ -277,10 +445,14 @@ void AirBloomAudioProcessorEditor::resized()
         getHeight() - edgePad - logoH + 20, // +4 to move down
         logoW, logoH);
 
+#if AIRBLOOM_PROFILE_STAGES
+    diagnostics.setTopLeftPosition(edgePad, topBarHeight + edgePad);
+#endif
+
 #if DEV_PRESET_SAVE
     const int  saveW = 60, saveH = 24;
-    const int  xSave = oversampleBox.getRight() + 8;
-    const int  ySave = oversampleBox.getY() + (oversampleBox.getHeight() - saveH) / 2;
+    const int  xSave = osFilterBox.getRight() + 8;
+    const int  ySave = osFilterBox.getY() + (osFilterBox.getHeight() - saveH) / 2;
     saveBtn.setBounds(xSave, ySave, saveW, saveH);
 #endif
 }
@@ -2,8 +2,13 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "AirBloomLookAndFeel.h"
+#include "LevelMeter.h"
+#include "SpectrumAnalyser.h"
+#include "DiagnosticsPanel.h"
 
-class AirBloomAudioProcessorEditor : public juce::AudioProcessorEditor
+class AirBloomAudioProcessorEditor : public juce::AudioProcessorEditor,
+                                     private juce::Timer,
+                                     private juce::ChangeListener
 {
 public:
     AirBloomAudioProcessorEditor(AirBloomAudioProcessor&);
@@ -14,6 +19,7 @@ public:
 
 private:
     AirBloomAudioProcessor& processorRef;
+    PresetManager&          presetMgr;                     // the processor's
 
     std::unique_ptr<AirBloomLookAndFeel> lookAndFeel;
     juce::Image                          backgroundImage;
@@ -21,18 +27,20 @@ private:
     // ── Top‐bar controls ────────────────────────────────────────────────────────
     static constexpr int topBarHeight = 60;
     juce::ComboBox     presetBox;
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;   // preset library changed
     juce::ToggleButton bypassButton, lowCutButton;
 
-    // ── Main knobs ──────────────────────────────────────────────────────────────
-    juce::Slider bloomSlider;
+    // ── Main knobs (repaint only when their film-strip frame changes) ───────────
+    FilmStripKnob bloomSlider{ AirBloomLookAndFeel::knobFrames };
     using BloomAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::unique_ptr<BloomAttachment> bloomAttachment;
 
-    juce::Slider reverbWetSlider;
+    FilmStripKnob reverbWetSlider{ AirBloomLookAndFeel::knobFrames };
     using WetAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::unique_ptr<WetAttachment> reverbWetAttachment;
 
-    juce::Slider inputGainSlider, outputGainSlider;
+    FilmStripKnob inputGainSlider{ AirBloomLookAndFeel::knobFrames },
+                  outputGainSlider{ AirBloomLookAndFeel::knobFrames };
     using GainAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::unique_ptr<GainAttachment> inputGainAttachment, outputGainAttachment;
 
@@ -41,8 +49,27 @@ private:
     std::unique_ptr<BtnAtt> bypassAttachment, lowCutAttachment;
 
     juce::ComboBox oversampleBox;                             // replaces ToggleButton
+    juce::ComboBox osFilterBox;                               // Standard / Linear Phase / Low Latency
     using ChoiceAtt = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
-    std::unique_ptr<ChoiceAtt> oversampleAttachment;
+    std::unique_ptr<ChoiceAtt> oversampleAttachment, osFilterAttachment;
+
+    juce::TooltipWindow tooltipWindow{ this };
+    bool oversampleCostPending = false;     // tooltip still says "measuring…"
+    void updateOversampleTooltip();
+
+    // ── Meters (fed from the processor's MeterFeed on the timer) ───────────────
+    LevelMeter        inputMeter, outputMeter;
+    ReductionMeter    clipMeter;                  // Bloom soft clip
+    MeterFeed::Levels inputShown, outputShown;    // with peak release
+    float             clipShown = 0.0f;
+    void timerCallback() override;
+
+    // ── Spectrum behind the Bloom knob (FFT on the analyser thread) ───────────
+    SpectrumAnalyser analyser{ processorRef.getMeterFeed() };
+    SpectrumDisplay  spectrumDisplay;
+    float            curveBloom = -1.0f;          // what the shelf curve was drawn for
+    double           curveRate = 0.0;
+    void updateShelfCurve();
 
     // ── Labels ─────────────────────────────────────────────────────────────────
     juce::Label bloomLabel, reverbLabel, inputGainLabel, outputGainLabel, panelLeft, panelCentre, panelRight;
@@ -56,6 +83,12 @@ private:
     juce::TextButton saveBtn{ "Save" };
 #endif
 
+#if AIRBLOOM_PROFILE_STAGES
+    // per-stage timings; double-click the logo to show / hide
+    DiagnosticsPanel diagnostics{ processorRef.getProfiler() };
+    void mouseDoubleClick(const juce::MouseEvent&) override;
+#endif
+
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AirBloomAudioProcessorEditor)
 };
@@ -1,6 +1,19 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
-#include <cmath>
+
+namespace
+{
+    juce::StringArray parameterIDsOf(const juce::AudioProcessor& p)
+    {
+        juce::StringArray ids;
+
+        for (auto* param : p.getParameters())
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(param))
+                ids.add(ranged->paramID);
+
+        return ids;
+    }
+}
 
 //==============================================================================
 AirBloomAudioProcessor::AirBloomAudioProcessor()
@@ -23,8 +36,23 @@ AirBloomAudioProcessor::AirBloomAudioProcessor()
     std::make_unique<juce::AudioParameterBool>("bypass", "Bypass", false),
     std::make_unique<juce::AudioParameterBool>("lowCut","Low-Cut",false),
     std::make_unique<juce::AudioParameterChoice>(
-        "oversample", "Oversample", juce::StringArray { juce::String::fromUTF8(u8"1×"), juce::String::fromUTF8(u8"2×"), juce::String::fromUTF8(u8"4×") }, 0)
-        })
+        "oversample", "Oversample", OversamplingMode::getFactorNames(), 0),
+    std::make_unique<juce::AudioParameterChoice>(
+        "osFilter", "OS Filter", OversamplingMode::getFilterNames(), 0),
+    std::make_unique<juce::AudioParameterFloat>("reverbDecay", "Reverb Decay",
+        juce::NormalisableRange<float>(0.3f, 10.0f, 0.01f, 0.5f), 1.5f),
+    std::make_unique<juce::AudioParameterFloat>("reverbSize", "Reverb Size",
+        juce::NormalisableRange<float>(0.0f, 1.0f), 0.8f),
+    std::make_unique<juce::AudioParameterFloat>("reverbDamping", "Reverb Damping",
+        juce::NormalisableRange<float>(0.0f, 1.0f), 0.2f),
+    std::make_unique<juce::AudioParameterChoice>(
+        "reverbOrder", "Reverb Lines", juce::StringArray{ "4", "8", "16" }, 1),
+    std::make_unique<juce::AudioParameterChoice>(
+        "bloomMode", "Bloom Mode", juce::StringArray{ "Stereo", "Mid/Side" }, 0),
+    std::make_unique<juce::AudioParameterFloat>("bloomSide", "Bloom Side",
+        juce::NormalisableRange<float>(0.0f, 1.0f), 1.0f)
+        }),
+    stateCodec(parameterIDsOf(*this))
 {
     bloomParam = parameters.getRawParameterValue("bloom");
     //atmosParam = parameters.getRawParameterValue("atmos");
@@ -36,242 +64,198 @@ AirBloomAudioProcessor::AirBloomAudioProcessor()
     bypassParam = parameters.getRawParameterValue("bypass");
     lowCutParam = parameters.getRawParameterValue("lowCut");
     oversampleParam = parameters.getRawParameterValue("oversample");
+    osFilterParam = parameters.getRawParameterValue("osFilter");
+    reverbDecayParam = parameters.getRawParameterValue("reverbDecay");
+    reverbSizeParam = parameters.getRawParameterValue("reverbSize");
+    reverbDampingParam = parameters.getRawParameterValue("reverbDamping");
+    reverbOrderParam = parameters.getRawParameterValue("reverbOrder");
+    bloomModeParam = parameters.getRawParameterValue("bloomMode");
+    bloomSideParam = parameters.getRawParameterValue("bloomSide");
+
+    for (const auto& id : parameterIDsOf(*this))
+    {
+        stateParams.push_back(parameters.getParameter(id));
+        stateValues.push_back(parameters.getRawParameterValue(id));
+    }
+
+    floatEngine.setProfiler(&profiler);
+    doubleEngine.setProfiler(&profiler);
 
-    presetManager = std::make_unique<PresetManager>(parameters);
+    presetManager = std::make_unique<PresetManager>(parameters, &presetMorph);
 
     if (parameters.state.getNumChildren() == 0)      // first-ever open
         presetManager->handleSelection("Init");
+
+    startTimerHz(10);   // picks up oversample changes off the audio thread
 }
 
 
 
-AirBloomAudioProcessor::~AirBloomAudioProcessor() {}
+AirBloomAudioProcessor::~AirBloomAudioProcessor()
+{
+    stopTimer();
+}
 
 //==============================================================================
 void AirBloomAudioProcessor::prepareToPlay(double sampleRate,
     int samplesPerBlock)
 {
-    // shared spec
     juce::dsp::ProcessSpec spec{
         sampleRate,
         (juce::uint32)samplesPerBlock,
         (juce::uint32)getTotalNumOutputChannels()
     };
-    softClipper.prepare(spec);
-    softClipper.functionToUse = [](float x)
-        {
-            // gentle analogue-style clip: 0 dBFS enters soft knee at ~-6 dB
-            constexpr float drive = 1.5f;
-            return std::tanh(x * drive);
-        };
-
-    prevInGain = 1.0f;
-    prevOutGain = 1.0f;
-    // 1) init shelf + drive ( unity )
-    shelfFilter.prepare(spec);
-    *shelfFilter.state = *juce::dsp::IIR::Coefficients<float>::makeHighShelf(
-        sampleRate, 10000.0f, 0.7071f, 1.0f);
-    driveGain.prepare(spec);
-    driveGain.setGainLinear(1.0f);
-
-    // 2) init HPF + reverb
-    reverbHpf.prepare(spec);
-    *reverbHpf.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
-        sampleRate, 800.0f, 0.7071f);
-
-    reverbProcessor.reset();
-    reverbProcessor.prepare(spec);
-    juce::Reverb::Parameters rp;
-    rp.roomSize = 0.8f;
-    rp.damping = 0.2f;
-    rp.wetLevel = 1.0f;  // pure wet here
-    rp.dryLevel = 0.0f;
-    rp.width = 1.0f;
-    rp.freezeMode = 0.0f;
-    reverbProcessor.setParameters(rp);
-
-    lowCutFilter.prepare(spec);
-    *lowCutFilter.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass
-    (sampleRate, 100.0f, 0.7071f);   // 100 Hz, Q ≈ 0.7
-
-    os2x = std::make_unique<juce::dsp::Oversampling<float>>(
-        getTotalNumOutputChannels(), /*factor*/ 2,
-        juce::dsp::Oversampling<float>::FilterType::filterHalfBandPolyphaseIIR);
-    os2x->initProcessing(samplesPerBlock);
-
-    os4x = std::make_unique<juce::dsp::Oversampling<float>>(
-        getTotalNumOutputChannels(), 4,
-        juce::dsp::Oversampling<float>::FilterType::filterHalfBandPolyphaseIIR);
-    os4x->initProcessing(samplesPerBlock);
-
-    constexpr double smoothTimeSec = 0.05;          // 50 ms ramp
-
-    bloomSm.reset(sampleRate, smoothTimeSec);
-    wetSm.reset(sampleRate, smoothTimeSec);
-
-    /* start at current param values so there’s no jump on first block */
-    bloomSm.setCurrentAndTargetValue(*bloomParam);
-    wetSm.setCurrentAndTargetValue(*reverbWetParam);
-
-
-    // 3) allocate temp buffers
-    int numCh = getTotalNumOutputChannels();
-    colorBuffer.setSize(numCh, samplesPerBlock, false, true, true);
-    reverbBuffer.setSize(numCh, samplesPerBlock, false, true, true);
 
+    // mono in, stereo out runs the engine's mono → stereo path
+    floatEngine.setNumInputChannels(getTotalNumInputChannels());
+    doubleEngine.setNumInputChannels(getTotalNumInputChannels());
+
+    // the host sets the precision before prepareToPlay(); the other
+    // engine gives its memory back
+    if (isUsingDoublePrecision())
+    {
+        floatEngine.release();
+        doubleEngine.prepare(spec, getSelectedOversamplingMode(), readParameters());
+    }
+    else
+    {
+        doubleEngine.release();
+        floatEngine.prepare(spec, getSelectedOversamplingMode(), readParameters());
+    }
+
+    setLatencySamples(getEngineLatency());
+    meterFeed.prepare(sampleRate);
+    presetMorph.prepare(sampleRate);
 }
 
-void AirBloomAudioProcessor::releaseResources() {}
+void AirBloomAudioProcessor::releaseResources()
+{
+    // audio has stopped, so the oversampler memory can go too
+    floatEngine.release();
+    doubleEngine.release();
+}
 
-//==============================================================================
-bool AirBloomAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
+int AirBloomAudioProcessor::getEngineLatency() const noexcept
 {
-    return layouts.getMainInputChannelSet() == layouts.getMainOutputChannelSet()
-        && !layouts.getMainInputChannelSet().isDisabled();
+    return isUsingDoublePrecision() ? doubleEngine.getLatencySamples()
+                                    : floatEngine.getLatencySamples();
 }
 
 //==============================================================================
-void AirBloomAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
-    juce::MidiBuffer& /*midi*/)
+AirBloomEngineBase::Parameters AirBloomAudioProcessor::readParameters() const noexcept
 {
-    juce::ScopedNoDenormals noDenormals;
+    AirBloomEngineBase::Parameters p;
+    p.bloom = bloomParam->load();
+    p.reverbWet = reverbWetParam->load();
+    p.inputGainDb = inputGainParam->load();
+    p.outputGainDb = outputGainParam->load();
+    p.bypass = bypassParam->load() > 0.5f;
+    p.lowCut = lowCutParam->load() > 0.5f;
+    p.oversample = static_cast<int>(oversampleParam->load() + 0.5f);
+    p.osFilter = static_cast<int>(osFilterParam->load() + 0.5f);
+    p.reverbDecay = reverbDecayParam->load();
+    p.reverbSize = reverbSizeParam->load();
+    p.reverbDamping = reverbDampingParam->load();
+    p.reverbOrder = static_cast<int>(reverbOrderParam->load() + 0.5f);
+    p.bloomMode = static_cast<int>(bloomModeParam->load() + 0.5f);
+    p.bloomSide = bloomSideParam->load();
+    return p;
+}
 
-    const int numCh = buffer.getNumChannels();
-    const int numSmp = buffer.getNumSamples();
-
-    // make sure our temps match
-    if (colorBuffer.getNumChannels() != numCh || colorBuffer.getNumSamples() != numSmp)
-        colorBuffer.setSize(numCh, numSmp, false, true, true);
-    if (reverbBuffer.getNumChannels() != numCh || reverbBuffer.getNumSamples() != numSmp)
-        reverbBuffer.setSize(numCh, numSmp, false, true, true);
-
-    // 1) read UI
-    bloomSm.setTargetValue(*bloomParam);
-    wetSm.setTargetValue(*reverbWetParam);
-    float bloom = bloomParam->load();
-    constexpr bool atmos = true;       // always ON now
-    float wetMix = reverbWetParam->load();
-    float inG = juce::Decibels::decibelsToGain(inputGainParam->load());
-    float outG = juce::Decibels::decibelsToGain(outputGainParam->load());
-    bool  doBypass = bypassParam->load() > 0.5f;
-    bool  doLowCut = lowCutParam->load() > 0.5f;
-
-    /* ---------- TRUE-BYPASS EARLY-OUT -------------------- */
-    if (doBypass)
-    {
-        prevInGain = 1.0f;   // reset so first un-bypass is clean
-        prevOutGain = 1.0f;
-        bloomSm.setCurrentAndTargetValue(*bloomParam);
-        wetSm.setCurrentAndTargetValue(*reverbWetParam);
-        return;
-    }
-    /* ----------------------------------------------------- */
+OversamplingMode AirBloomAudioProcessor::getSelectedOversamplingMode() const
+{
+    return readParameters().getOversamplingMode(isNonRealtime());
+}
 
-    {
-        const float newGain = inG;
-        for (int ch = 0; ch < numCh; ++ch)
-            buffer.applyGainRamp(ch, 0, numSmp, prevInGain, newGain);
-        prevInGain = newGain;
-    }
+OversamplingMode::Cost AirBloomAudioProcessor::getOversamplingCost(int factorChoice,
+                                                                   int filterChoice)
+{
+    return oversamplingCosts->get(
+        OversamplingMode{ factorChoice, (OversamplingMode::Filter)filterChoice }
+            .resolvedFor(isNonRealtime()));
+}
 
-    /* ---------- OPTIONAL MAIN-PATH HPF ------------------- */
-    if (doLowCut)
-    {
-        juce::dsp::AudioBlock<float> lb(buffer);
-        juce::dsp::ProcessContextReplacing<float> ctx(lb);
-        lowCutFilter.process(ctx);
-    } 
-    /* ----------------------------------------------------- */
+double AirBloomAudioProcessor::getShelfSampleRate() const
+{
+    const double rate = getSampleRate() > 0.0 ? getSampleRate() : 44100.0;
+    return rate * (double)getSelectedOversamplingMode().getFactor();
+}
 
-    // 2) compute & configure shelf+drive
-    constexpr float intensity = 4.0f;  // tweak for more/less presence
-    constexpr float maxShelfDb = 12.0f;
-    constexpr float maxDriveDb = 8.0f;
+// message thread: new oversampling mode (factor, filter, or the host
+// switching to/from offline rendering) → new colour path + latency
+void AirBloomAudioProcessor::timerCallback()
+{
+    // an unprepared engine ignores this
+    const auto mode = getSelectedOversamplingMode();
+    const bool changed = floatEngine.updateColourPath(mode);
 
-    float shelfDb = bloom * maxShelfDb * intensity;
-    float driveDb = bloom * maxDriveDb * intensity;
+    if (doubleEngine.updateColourPath(mode) || changed)
+        setLatencySamples(getEngineLatency());
+}
 
-    float shelfG = juce::Decibels::decibelsToGain(shelfDb);
-    float driveG = juce::Decibels::decibelsToGain(driveDb);
+double AirBloomAudioProcessor::getTailLengthSeconds() const
+{
+    return AirBloomEngineBase::getTailSeconds(readParameters());
+}
 
-    *shelfFilter.state = *juce::dsp::IIR::Coefficients<float>::makeHighShelf(
-        getSampleRate(), 10000.0f, 0.7071f, shelfG);
-    driveGain.setGainLinear(driveG);
+//==============================================================================
+bool AirBloomAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
+{
+    const auto in = layouts.getMainInputChannelSet();
+    const auto out = layouts.getMainOutputChannelSet();
 
-    // 3) run colour stage on a temp copy (oversampled if asked for)
-    for (int ch = 0; ch < numCh; ++ch)
-        colorBuffer.copyFrom(ch, 0, buffer, ch, 0, numSmp);
+    if (in.isDisabled() || out.size() > AirBloomEngineBase::maxChannels)
+        return false;
 
-    juce::dsp::AudioBlock<float> baseBlock(colorBuffer);
-    auto choice = static_cast<int>(oversampleParam->load() + 0.5f);
+    // anything from mono up to a 9.1.6 bed, same layout in and out – or
+    // mono in, stereo out (the engine widens it with the reverb)
+    return in == out
+        || (in == juce::AudioChannelSet::mono() && out == juce::AudioChannelSet::stereo());
+}
 
-    if (choice == 1 || choice == 2)            // 2× or 4×
-    {
-        auto& os = (choice == 1 ? *os2x : *os4x);
-        auto upBlock = os.processSamplesUp(baseBlock);          // oversample
+//==============================================================================
+template <typename SampleType>
+void AirBloomAudioProcessor::runEngine(AirBloomEngine<SampleType>& engine,
+                                       juce::AudioBuffer<SampleType>& buffer)
+{
+    juce::ScopedNoDenormals noDenormals;
+    const RealtimeGuard::ScopedSection rtSection;
 
-        juce::dsp::ProcessContextReplacing<float> hiCtx(upBlock);
-        shelfFilter.process(hiCtx);
-        driveGain.process(hiCtx);
-        softClipper.process(hiCtx);
+    // levels are only measured while an editor is reading them
+    const bool metering = meterFeed.isConsumerActive();
+    MeterFeed::Frame frame;
 
-        os.processSamplesDown(baseBlock);                       // back to 1×
-    }
-    else                                        // 1× (no OS)
-    {
-        juce::dsp::ProcessContextReplacing<float> loCtx(baseBlock);
-        shelfFilter.process(loCtx);
-        driveGain.process(loCtx);
-        softClipper.process(loCtx);
-    }
+    if (metering)
+        frame.in = MeterFeed::measure(buffer, getTotalNumInputChannels());
 
-    // 4) cross-fade Bloom: dry*(1−bloom) + color*bloom
-    for (int ch = 0; ch < numCh; ++ch)
-    {
-        auto* dry = buffer.getWritePointer(ch);
-        auto* col = colorBuffer.getReadPointer(ch);
-        for (int i = 0; i < numSmp; ++i)
-        {
-            const float b = bloomSm.getNextValue();          // ← smooth here
-            dry[i] = dry[i] * (1.0f - b) + col[i] * b;
-        }
-    }
+    engine.setParameters(presetMorph.process(readParameters(), buffer.getNumSamples()));
+    engine.process(buffer);
 
+    frame.clipReductionDb = engine.takeClipGainReductionDb();
 
-    // 5) optionally reverb that coloured signal
-    if (atmos && wetMix > 0.0f)
-    {
-        // copy the just-coloured audio
-        for (int ch = 0; ch < numCh; ++ch)
-            reverbBuffer.copyFrom(ch, 0, buffer, ch, 0, numSmp);
-
-        {
-            juce::dsp::AudioBlock<float>        rb(reverbBuffer);
-            juce::dsp::ProcessContextReplacing<float> rctx(rb);
-            reverbHpf.process(rctx);
-            reverbProcessor.process(rctx);
-        }
-
-        // cross-fade reverb tail in
-        for (int ch = 0; ch < numCh; ++ch)
-        {
-            auto* dry = buffer.getWritePointer(ch);
-            auto* wet = reverbBuffer.getReadPointer(ch);
-            for (int i = 0; i < numSmp; ++i){
-                const float w = wetSm.getNextValue();            // ← smooth here
-                dry[i] = dry[i] * (1.0f - w) + wet[i] * w;
-            }
-        }
-    }
-    /* ----------------- OUTPUT GAIN (smoothed) --------------- */
+    if (metering)
     {
-        const float newGain = outG * juce::Decibels::decibelsToGain(-5.0f);
-        for (int ch = 0; ch < numCh; ++ch)
-            buffer.applyGainRamp(ch, 0, numSmp, prevOutGain, newGain);
-        prevOutGain = newGain;
+        frame.out = MeterFeed::measure(buffer, getTotalNumOutputChannels());
+        frame.numSamples = buffer.getNumSamples();
+        meterFeed.push(frame);
+        meterFeed.pushAnalysis(buffer, getTotalNumOutputChannels());
     }
 }
 
+void AirBloomAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer,
+    juce::MidiBuffer& /*midi*/)
+{
+    runEngine(floatEngine, buffer);
+}
+
+// 64-bit hosts get the same chain run natively in double – no conversion,
+// and the reverb's feedback loops keep their precision
+void AirBloomAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer,
+    juce::MidiBuffer& /*midi*/)
+{
+    runEngine(doubleEngine, buffer);
+}
+
 //==============================================================================
 juce::AudioProcessorEditor* AirBloomAudioProcessor::createEditor()
 {
@@ -284,17 +268,49 @@ bool AirBloomAudioProcessor::hasEditor() const
 }
 
 //==============================================================================
+// hosts call these for every undo snapshot and autosave: the raw values
+// straight out, no ValueTree or XML in between
 void AirBloomAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    if (auto xml = parameters.copyState().createXml())
-        copyXmlToBinary(*xml, destData);
+    std::vector<float> values(stateValues.size());
+
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = stateValues[i]->load();
+
+    stateCodec.write(values.data(), destData);
 }
 
 void AirBloomAudioProcessor::setStateInformation(const void* data,
     int sizeInBytes)
 {
-    if (auto xml = getXmlFromBinary(data, sizeInBytes))
-        parameters.replaceState(juce::ValueTree::fromXml(*xml));
+    if (sizeInBytes <= 0)
+        return;
+
+    // the host's state wins over an "Init" still waiting on the first scan
+    presetManager->cancelPendingSelection();
+
+    if (!StateCodec::isBinaryState(data, (size_t)sizeInBytes))
+    {
+        // saved before the binary format: XML, as it always was read
+        if (auto xml = getXmlFromBinary(data, sizeInBytes))
+            parameters.replaceState(juce::ValueTree::fromXml(*xml));
+
+        return;
+    }
+
+    const auto num = stateParams.size();
+    std::vector<float> values(num);
+    juce::HeapBlock<bool> found(num);
+
+    if (!stateCodec.read(data, (size_t)sizeInBytes, values.data(), found))
+        return;                             // from a newer build, or damaged
+
+    // like replaceState(): anything the state doesn't mention goes to its default
+    for (size_t i = 0; i < num; ++i)
+    {
+        auto* p = stateParams[i];
+        p->setValueNotifyingHost(found[i] ? p->convertTo0to1(values[i]) : p->getDefaultValue());
+    }
 }
 
 //==============================================================================
@@ -2,8 +2,14 @@
 #include <JuceHeader.h>
 #include <juce_dsp/juce_dsp.h>   // already there, but make sure it’s included
 #include "PresetManager.h"
-
-class AirBloomAudioProcessor : public juce::AudioProcessor
+#include "PresetMorph.h"
+#include "AirBloomEngine.h"
+#include "RealtimeGuard.h"
+#include "MeterFeed.h"
+#include "StateCodec.h"
+
+class AirBloomAudioProcessor : public juce::AudioProcessor,
+                               private juce::Timer
 {
 public:
     AirBloomAudioProcessor();
@@ -14,6 +20,8 @@ public:
     void releaseResources() override;
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -23,7 +31,7 @@ public:
     const juce::String getName() const override { return "AirBloom"; }
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override;
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -44,51 +52,64 @@ public:
     std::atomic<float>* outputGainParam = nullptr;
     std::atomic<float>* bypassParam = nullptr;
     std::atomic<float>* lowCutParam = nullptr;
+    std::atomic<float>* reverbDecayParam = nullptr;
+    std::atomic<float>* reverbSizeParam = nullptr;
+    std::atomic<float>* reverbDampingParam = nullptr;
+    std::atomic<float>* reverbOrderParam = nullptr;
+    std::atomic<float>* bloomModeParam = nullptr;          // stereo / mid-side
+    std::atomic<float>* bloomSideParam = nullptr;
 
+    /* CPU / latency of an oversample × osFilter combination, as it would
+       run right now (8×/16× fall back to 4× unless rendering offline);
+       message thread, CPU may still be being measured                   */
+    OversamplingMode::Cost getOversamplingCost(int factorChoice, int filterChoice);
 
-private:
-    // — stereo-safe high-shelf filter —
-    using Shelf = juce::dsp::ProcessorDuplicator<
-        juce::dsp::IIR::Filter<float>,
-        juce::dsp::IIR::Coefficients<float>
-    >;
-    Shelf        shelfFilter;
-    juce::dsp::Gain<float> driveGain;
-
-    // — stereo-safe high-pass + reverb chain —
-    using HPF = juce::dsp::ProcessorDuplicator<
-        juce::dsp::IIR::Filter<float>,
-        juce::dsp::IIR::Coefficients<float>
-    >;
-    HPF          reverbHpf;
-    juce::dsp::Reverb reverbProcessor;
-
-    // — temp buffers to avoid per-block allocation —
-    juce::AudioBuffer<float> colorBuffer, reverbBuffer;
-
-    /* ★ NEW ↓  12 dB /oct high-pass for the main signal */
-    using HPF = juce::dsp::ProcessorDuplicator<
-        juce::dsp::IIR::Filter<float>,
-        juce::dsp::IIR::Coefficients<float>>;
-    HPF          lowCutFilter;
-
-    /* private:  … existing DSP members … */
-    juce::dsp::WaveShaper<float> softClipper;   // ★ NEW
+    /* the rate the Bloom shelf runs at right now (host rate × oversampling) */
+    double getShelfSampleRate() const;
+
+    /* levels, clip gain reduction and analyser audio for the editor */
+    MeterFeed& getMeterFeed() noexcept { return meterFeed; }
+
+    /* this instance's presets (the library behind them is shared) */
+    PresetManager& getPresetManager() noexcept { return *presetManager; }
 
+    /* per-stage engine timings (empty unless built with AIRBLOOM_PROFILE_STAGES) */
+    StageProfiler& getProfiler() noexcept { return profiler; }
+
+
+private:
     /* ── parameters ───────────────────────────────────────────── */
     std::atomic<float>* oversampleParam = nullptr;          // ★ NEW
+    std::atomic<float>* osFilterParam = nullptr;
 
-    /* ── DSP helpers ──────────────────────────────────────────── */
-    std::unique_ptr<juce::dsp::Oversampling<float>> os2x;    // 2 ×
-    std::unique_ptr<juce::dsp::Oversampling<float>> os4x;    // 4 ×
+    AirBloomEngineBase::Parameters readParameters() const noexcept;
+    OversamplingMode getSelectedOversamplingMode() const;
 
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> bloomSm;
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> wetSm;
+    // all the DSP lives in the engine (shared with the AirBloomRender
+    // tool); the timer builds new colour paths for it off the audio thread.
+    // One per precision – only the one the host asked for is prepared.
+    AirBloomEngine<float>  floatEngine;
+    AirBloomEngine<double> doubleEngine;
+    void timerCallback() override;
 
-    std::unique_ptr<PresetManager> presetManager;
+    template <typename SampleType>
+    void runEngine(AirBloomEngine<SampleType>& engine, juce::AudioBuffer<SampleType>& buffer);
+
+    int getEngineLatency() const noexcept;
+
+    // host state: raw parameter values as binary (see StateCodec.h),
+    // in the order of getParameters()
+    StateCodec stateCodec;
+    std::vector<juce::RangedAudioParameter*> stateParams;
+    std::vector<std::atomic<float>*>         stateValues;
 
-    float prevInGain = 1.0f;
-    float prevOutGain = 1.0f;
+    MeterFeed meterFeed;
+    StageProfiler profiler;              // both engines record here; only one runs
+
+    PresetMorph presetMorph;             // recalled presets glide in (see PresetMorph.h)
+    juce::SharedResourcePointer<OversamplingCosts> oversamplingCosts;   // hover text only
+
+    std::unique_ptr<PresetManager> presetManager;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AirBloomAudioProcessor)
 };
@@ -0,0 +1,221 @@
+#include "PresetLibrary.h"
+
+namespace
+{
+    bool nameOrder(const PresetLibrary::PresetPtr& a, const PresetLibrary::PresetPtr& b)
+    {
+        return a->name.compareNatural(b->name) < 0;
+    }
+
+    PresetLibrary::Index::const_iterator findIn(const PresetLibrary::Index& index, const juce::String& name)
+    {
+        // natural order ignores case, so step through the names that compare equal
+        auto it = std::lower_bound(index.begin(), index.end(), name,
+                                   [](const PresetLibrary::PresetPtr& p, const juce::String& n)
+                                   { return p->name.compareNatural(n) < 0; });
+
+        for (; it != index.end() && (*it)->name.compareNatural(name) == 0; ++it)
+            if ((*it)->name == name)
+                return it;
+
+        return index.end();
+    }
+}
+
+//===========================================================================
+PresetLibrary::PresetLibrary() : PresetLibrary(getDefaultDirectory())
+{
+}
+
+PresetLibrary::PresetLibrary(const juce::File& dir)
+    : juce::Thread("AirBloom presets"),
+      directory(dir),
+      index(std::make_shared<const Index>())
+{
+    startThread();
+}
+
+PresetLibrary::~PresetLibrary()
+{
+    stopThread(4000);       // a listing on a slow network share can take a while
+}
+
+juce::File PresetLibrary::getDefaultDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+        .getChildFile("AirBloom Presets");
+}
+
+std::shared_ptr<const PresetLibrary::Index> PresetLibrary::getIndex() const
+{
+    const juce::ScopedLock sl(indexLock);
+    return index;
+}
+
+PresetLibrary::PresetPtr PresetLibrary::find(const juce::String& name) const
+{
+    const auto snapshot = getIndex();
+    const auto it = findIn(*snapshot, name);
+    return it != snapshot->end() ? *it : nullptr;
+}
+
+juce::File PresetLibrary::fileFor(const juce::String& name) const
+{
+    return directory.getChildFile(name + ".abp");
+}
+
+//===========================================================================
+PresetLibrary::PresetPtr PresetLibrary::load(const juce::File& file)
+{
+    const auto modified = file.getLastModificationTime();
+
+    if (auto xml = juce::XmlDocument::parse(file))
+        return fromXml(file.getFileNameWithoutExtension(), modified, *xml);
+
+    return nullptr;
+}
+
+// .abp presets are the plug-in's parameter state as XML
+PresetLibrary::PresetPtr PresetLibrary::fromXml(const juce::String& name, juce::Time modified,
+                                                const juce::XmlElement& xml)
+{
+    auto p = std::make_shared<Preset>();
+    p->name = name;
+    p->modified = modified;
+
+    for (auto* e : xml.getChildWithTagNameIterator("PARAM"))
+        p->values.push_back({ e->getStringAttribute("id"), (float)e->getDoubleAttribute("value") });
+
+    return p;
+}
+
+// swaps in `next` unless someone else published since `expected` was read
+bool PresetLibrary::publish(const std::shared_ptr<const Index>& expected, Index next)
+{
+    auto replacement = std::make_shared<const Index>(std::move(next));
+
+    {
+        const juce::ScopedLock sl(indexLock);
+
+        if (index != expected)
+            return false;
+
+        index = std::move(replacement);
+    }
+
+    sendChangeMessage();
+    return true;
+}
+
+//===========================================================================
+// message thread (or wherever the caller is)
+bool PresetLibrary::save(const juce::String& name, const juce::XmlElement& xml)
+{
+    const auto file = fileFor(name);
+
+    if (!directory.createDirectory() || !xml.writeTo(file))
+        return false;
+
+    const auto preset = fromXml(name, file.getLastModificationTime(), xml);
+
+    for (;;)
+    {
+        const auto current = getIndex();
+        Index next(*current);
+
+        if (auto it = findIn(next, name); it != next.end())
+            next[(size_t)(it - next.begin())] = preset;
+        else
+            next.insert(std::upper_bound(next.begin(), next.end(), preset, nameOrder), preset);
+
+        if (publish(current, std::move(next)))
+            return true;
+    }
+}
+
+void PresetLibrary::remove(const juce::String& name)
+{
+    fileFor(name).deleteFile();
+
+    for (;;)
+    {
+        const auto current = getIndex();
+        const auto it = findIn(*current, name);
+
+        if (it == current->end())
+            return;
+
+        Index next(*current);
+        next.erase(next.begin() + (it - current->begin()));
+
+        if (publish(current, std::move(next)))
+            return;
+    }
+}
+
+//===========================================================================
+// scanning thread
+void PresetLibrary::run()
+{
+    directory.createDirectory();    // make sure it exists
+
+    while (!threadShouldExit())
+    {
+        // lost a race with save() / remove(): go again straight away
+        if (!scan())
+            continue;
+
+        wait(pollIntervalMs);
+    }
+}
+
+bool PresetLibrary::scan()
+{
+    const auto dirTime = directory.getLastModificationTime();
+
+    if (loaded.load() && dirTime == lastDirectoryTime && ++pollsSinceListing < listingEvery)
+        return true;
+
+    pollsSinceListing = 0;
+    lastDirectoryTime = dirTime;
+
+    const auto current = getIndex();
+    Index next;
+    bool changed = false;
+
+    for (const auto& entry : juce::RangedDirectoryIterator(directory, false, "*.abp", juce::File::findFiles))
+    {
+        if (threadShouldExit())
+            return true;
+
+        const auto& file = entry.getFile();
+        const auto it = findIn(*current, file.getFileNameWithoutExtension());
+
+        if (it != current->end() && (*it)->modified == entry.getModificationTime())
+        {
+            next.push_back(*it);
+        }
+        else if (auto p = load(file))
+        {
+            next.push_back(std::move(p));
+            changed = true;
+        }
+    }
+
+    changed = changed || next.size() != current->size();    // removals
+
+    // the first scan always publishes, so listeners hear the library is loaded
+    if (changed || !loaded.load())
+    {
+        std::sort(next.begin(), next.end(), nameOrder);
+
+        if (!publish(current, std::move(next)))
+        {
+            lastDirectoryTime = juce::Time();   // list it again next time round
+            return false;
+        }
+    }
+
+    loaded = true;
+    return true;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <JuceHeader.h>
+
+/*  Every .abp preset in a folder, parsed and held in memory.
+
+    A background thread reads the folder once when the library is made,
+    then keeps polling it. Each poll costs one stat of the folder unless
+    its modification time has moved (a preset added, removed or saved
+    over); then, and every listingEvery polls regardless, it lists the
+    folder again. Only files that are new or newer than their cached copy
+    are parsed again. Listeners hear about changes through
+    ChangeBroadcaster, on the message thread.
+
+    Lookups hand out an immutable snapshot of the index, so recalling a
+    preset touches neither the disk nor an XML parser. Saves and removals
+    made through the library update it straight away, without waiting for
+    the next poll.
+
+    Hold the user folder's library through a
+    juce::SharedResourcePointer<PresetLibrary>: every plug-in instance in
+    the process then shares one index and one scanning thread, which
+    lives as long as any instance does.                                  */
+class PresetLibrary : public juce::ChangeBroadcaster,
+                      private juce::Thread
+{
+public:
+    struct Value
+    {
+        juce::String id;
+        float value = 0.0f;                     // raw, as in the file
+    };
+
+    struct Preset
+    {
+        juce::String       name;                // file name without .abp
+        juce::Time         modified;
+        std::vector<Value> values;
+    };
+
+    using PresetPtr = std::shared_ptr<const Preset>;
+    using Index = std::vector<PresetPtr>;       // sorted by name, natural order
+
+    static constexpr int pollIntervalMs = 2000;
+    static constexpr int listingEvery = 15;     // polls
+
+    PresetLibrary();                             // getDefaultDirectory()
+    explicit PresetLibrary(const juce::File& directory);
+    ~PresetLibrary() override;
+
+    /* ~/Documents/AirBloom Presets */
+    static juce::File getDefaultDirectory();
+
+    const juce::File& getDirectory() const noexcept { return directory; }
+
+    /* true once the first scan has finished */
+    bool isLoaded() const noexcept { return loaded.load(); }
+
+    //==========================================================================
+    // any thread
+    std::shared_ptr<const Index> getIndex() const;
+    PresetPtr find(const juce::String& name) const;
+
+    /* writes the preset's XML to the folder and caches it; false if the
+       file couldn't be written */
+    bool save(const juce::String& name, const juce::XmlElement& xml);
+    void remove(const juce::String& name);
+
+    /* parses one .abp – what the scan does for each new file */
+    static PresetPtr load(const juce::File& file);
+    static PresetPtr fromXml(const juce::String& name, juce::Time modified, const juce::XmlElement& xml);
+
+private:
+    void run() override;
+    bool scan();
+    bool publish(const std::shared_ptr<const Index>& expected, Index next);
+
+    juce::File fileFor(const juce::String& name) const;
+
+    const juce::File directory;
+
+    juce::CriticalSection        indexLock;     // held only to swap / copy the pointer
+    std::shared_ptr<const Index> index;
+
+    std::atomic<bool> loaded{ false };
+
+    // — scanning thread only —
+    juce::Time lastDirectoryTime;
+    int pollsSinceListing = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(PresetLibrary)
+};
@@ -1,31 +1,96 @@
 #include "PresetManager.h"
 
 //===========================================================================
-// location:  ~/Documents/AirBloom Presets/
-PresetManager::PresetManager(juce::AudioProcessorValueTreeState& s)
-    : state(s),
-    userDir(juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
-        .getChildFile("AirBloom Presets"))
+// location:  ~/Documents/AirBloom Presets/ (PresetLibrary::getDefaultDirectory)
+PresetManager::PresetManager(juce::AudioProcessorValueTreeState& s, PresetMorph* m)
+    : state(s), morph(m)
 {
-    userDir.createDirectory();   // make sure it exists
+    library->addChangeListener(this);
+}
+
+PresetManager::~PresetManager()
+{
+    library->removeChangeListener(this);
 }
 
 //===========================================================================
 void PresetManager::refreshMenu(juce::ComboBox& box) const
 {
-    box.clear();
+    const auto selected = box.getText();
+
+    box.clear(juce::dontSendNotification);
     int id = 1;
 
-    for (auto f : userDir.findChildFiles(juce::File::findFiles, false, "*.abp"))
-        box.addItem(f.getFileNameWithoutExtension(), id++);
+    for (const auto& p : *library->getIndex())
+    {
+        box.addItem(p->name, id);
+
+        if (p->name == selected)
+            box.setSelectedId(id, juce::dontSendNotification);
+
+        ++id;
+    }
 }
 
 // ────────────────────────────────────────────────────────────────────────
-// ‣ 3.  LOAD: disk only
+// ‣ 3.  LOAD: from the cache
 void PresetManager::handleSelection(const juce::String& name)
 {
-    if (auto xml = juce::XmlDocument::parse(userFile(name)))
-        state.replaceState(juce::ValueTree::fromXml(*xml));
+    pendingSelection.clear();
+
+    if (auto preset = library->find(name))
+        apply(*preset);
+    else if (!library->isLoaded())       // asked for before the first scan is done
+        pendingSelection = name;
+}
+
+// the library published – the first scan's index has every preset in the
+// folder, so a waiting selection is either in it or not there at all
+void PresetManager::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    if (pendingSelection.isEmpty())
+        return;
+
+    if (auto preset = library->find(pendingSelection))
+    {
+        pendingSelection.clear();
+        apply(*preset);
+    }
+    else if (library->isLoaded())
+    {
+        pendingSelection.clear();
+    }
+}
+
+// like replaceState(): whatever the preset doesn't set goes to its default.
+// The audio thread gets the whole preset first, so it can glide there while
+// the parameters themselves (and the host) jump.
+void PresetManager::apply(const PresetLibrary::Preset& preset)
+{
+    std::vector<std::pair<juce::RangedAudioParameter*, float>> values;   // normalised
+    PresetMorph::Parameters target;
+
+    for (auto* param : state.processor.getParameters())
+    {
+        auto* p = dynamic_cast<juce::RangedAudioParameter*>(param);
+
+        if (p == nullptr)
+            continue;
+
+        const auto it = std::find_if(preset.values.begin(), preset.values.end(),
+                                     [p](const PresetLibrary::Value& v) { return v.id == p->paramID; });
+
+        const float value = it != preset.values.end() ? p->convertTo0to1(it->value)
+                                                      : p->getDefaultValue();
+        values.emplace_back(p, value);
+        target.set(p->paramID, p->convertFrom0to1(value));
+    }
+
+    if (morph != nullptr && morphSeconds > 0.0)
+        morph->post(target, morphSeconds);
+
+    for (const auto& [p, value] : values)
+        p->setValueNotifyingHost(value);
 }
 
 //===========================================================================
@@ -35,19 +100,12 @@ void PresetManager::savePresetAs(const juce::String& name)
     if (name.isEmpty()) return;
 
     if (auto xml = state.copyState().createXml())
-        xml->writeTo(userFile(name));
+        library->save(name, *xml);
 }
 
 //===========================================================================
 // delete
 void PresetManager::deleteUserPreset(const juce::String& name)
 {
-    userFile(name).deleteFile();
-}
-
-//===========================================================================
-// helpers
-juce::File PresetManager::userFile(const juce::String& nm) const
-{
-    return userDir.getChildFile(nm + ".abp");
+    library->remove(name);
 }
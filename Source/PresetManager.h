@@ -1,24 +1,48 @@
 #pragma once
 #include <JuceHeader.h>
+#include "PresetLibrary.h"
+#include "PresetMorph.h"
 
-class PresetManager
+/*  Presets for one parameter tree – one per processor. The .abp files
+    themselves are read, cached and watched by the PresetLibrary every
+    instance in the process shares, so listing and recalling them never
+    touches the disk, and another instance costs no scan. Given the
+    processor's PresetMorph, a recalled preset glides in over
+    getMorphSeconds() rather than jumping.                               */
+class PresetManager : private juce::ChangeListener
 {
 public:
-    explicit PresetManager(juce::AudioProcessorValueTreeState&);
+    explicit PresetManager(juce::AudioProcessorValueTreeState&, PresetMorph* morph = nullptr);
+    ~PresetManager() override;
 
     /* UI hooks */
-    void refreshMenu(juce::ComboBox& box) const;   // just lists .abp files
-    void handleSelection(const juce::String& preset);  // loads that file
+    void refreshMenu(juce::ComboBox& box) const;   // lists the cached presets, keeps the selection
+    void handleSelection(const juce::String& preset);  // recalls it from the cache
+    void cancelPendingSelection() noexcept { pendingSelection.clear(); }   // state restored over it
     void savePresetAs(const juce::String& name);
     void deleteUserPreset(const juce::String& name);
 
+    /* how long a recall glides for; 0 jumps */
+    void   setMorphSeconds(double s) noexcept { morphSeconds = juce::jmax(0.0, s); }
+    double getMorphSeconds() const noexcept   { return morphSeconds; }
+
+    /* broadcasts when presets come, go or change on disk */
+    PresetLibrary& getLibrary() noexcept { return *library; }
+
     /* optional helper – prints current params to console */
     juce::String dumpCurrentParams() const;
 
 private:
     juce::AudioProcessorValueTreeState& state;
-    const juce::File userDir;
+    juce::SharedResourcePointer<PresetLibrary> library;
+    PresetMorph* morph = nullptr;
+    double morphSeconds = 0.25;
+
+    // asked for before the library's first scan finished: recalled when
+    // it has, rather than read from disk here on the message thread
+    juce::String pendingSelection;
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;
 
     /* helpers */
-    juce::File userFile(const juce::String& name) const;
+    void apply(const PresetLibrary::Preset& preset);
 };
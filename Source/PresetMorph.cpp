@@ -0,0 +1,76 @@
+#include "PresetMorph.h"
+
+namespace
+{
+    float lerp(float a, float b, float t) noexcept { return a + (b - a) * t; }
+}
+
+//===========================================================================
+void PresetMorph::prepare(double rate) noexcept
+{
+    sampleRate = rate;
+    haveLast = false;
+    morphing = false;
+}
+
+// message thread
+void PresetMorph::post(const Parameters& target, double seconds) noexcept
+{
+    auto& m = slots[(size_t)back];
+    m.target = target;
+    m.seconds = seconds;
+
+    back = middle.exchange(back | freshBit) & ~freshBit;
+}
+
+//===========================================================================
+// audio thread
+void PresetMorph::begin(const Message& m) noexcept
+{
+    from = last;
+    to = m.target;
+
+    progress.reset(sampleRate, juce::jmax(0.0, m.seconds));
+    progress.setCurrentAndTargetValue(0.0f);
+    progress.setTargetValue(1.0f);
+
+    morphing = progress.isSmoothing();
+}
+
+PresetMorph::Parameters PresetMorph::process(const Parameters& host, int numSamples) noexcept
+{
+    if (!haveLast)
+    {
+        last = host;
+        haveLast = true;
+    }
+
+    if ((middle.load() & freshBit) != 0)
+    {
+        front = middle.exchange(front) & ~freshBit;
+        begin(slots[(size_t)front]);
+    }
+
+    if (!morphing)
+    {
+        last = host;
+        return host;
+    }
+
+    const float t = progress.skip(numSamples);
+    morphing = progress.isSmoothing();
+
+    // switches are the preset's from the first block (the engine fades them)
+    auto p = to;
+    p.bloom = lerp(from.bloom, to.bloom, t);
+    p.bloomSide = lerp(from.bloomSide, to.bloomSide, t);
+    p.reverbWet = lerp(from.reverbWet, to.reverbWet, t);
+    p.inputGainDb = lerp(from.inputGainDb, to.inputGainDb, t);
+    p.outputGainDb = lerp(from.outputGainDb, to.outputGainDb, t);
+    p.reverbDecay = lerp(from.reverbDecay, to.reverbDecay, t);
+    p.reverbSize = lerp(from.reverbSize, to.reverbSize, t);
+    p.reverbDamping = lerp(from.reverbDamping, to.reverbDamping, t);
+
+    last = p;
+    return p;
+}
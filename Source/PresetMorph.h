@@ -0,0 +1,67 @@
+#pragma once
+#include "AirBloomEngine.h"
+
+/*  Glides the engine from where it is to a recalled preset instead of
+    jumping there.
+
+    The message thread post()s the preset's parameters; they reach the
+    audio thread through a lock-free mailbox (a triple buffer – the latest
+    post wins, nothing blocks, nothing allocates). process() then hands the
+    engine a blend of the two, advanced once per block: the continuous
+    parameters move in a straight line from the values last handed out to
+    the preset's over the morph time, and the engine's own smoothers take
+    care of what's left inside each block. A post during a morph starts
+    the next one from wherever this one had got to.
+
+    Switches are handed to the engine as the preset's from the first block,
+    and the engine crossfades each of them itself: bypass fades the
+    processing out, a Bloom mode change blends the old and new mode's
+    decoded mixes, a new reverb order starts a second network while the
+    old tail rings out, and low cut and the oversampling mode crossfade as
+    they always have. Between morphs process() passes the host's
+    parameters straight through, and while one runs it ignores them – post
+    first, then set the parameters to the same values, and the hand-over at
+    the end is seamless.
+
+    Threads:
+      prepare()   audio stopped
+      post()      message thread (any one thread)
+      process()   audio thread, once per block                           */
+class PresetMorph
+{
+public:
+    using Parameters = AirBloomEngineBase::Parameters;
+
+    void prepare(double sampleRate) noexcept;
+
+    /* glide to `target` over `seconds` (0 = jump straight there) */
+    void post(const Parameters& target, double seconds) noexcept;
+
+    /* what the engine should run this block, given the host's parameters */
+    Parameters process(const Parameters& host, int numSamples) noexcept;
+
+    bool isMorphing() const noexcept { return morphing; }
+
+private:
+    struct Message
+    {
+        Parameters target;
+        double seconds = 0.0;
+    };
+
+    void begin(const Message& m) noexcept;
+
+    // — triple buffer: back written by post(), front read by process(),
+    //   middle swapped between them with freshBit set when it's new —
+    static constexpr int freshBit = 4;
+    std::array<Message, 3> slots{};
+    std::atomic<int> middle{ 1 };
+    int back = 0, front = 2;
+
+    // — audio thread only —
+    double sampleRate = 44100.0;
+    Parameters from, to, last;
+    bool haveLast = false;                  // nothing handed out since prepare()
+    bool morphing = false;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> progress;    // 0 → 1
+};
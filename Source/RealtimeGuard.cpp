@@ -0,0 +1,86 @@
+#include "RealtimeGuard.h"
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    thread_local int sectionDepth = 0;
+    std::atomic<RealtimeGuard::Handler> handler{ nullptr };
+}
+
+//===========================================================================
+RealtimeGuard::ScopedSection::ScopedSection() noexcept { ++sectionDepth; }
+RealtimeGuard::ScopedSection::~ScopedSection() noexcept { --sectionDepth; }
+
+bool RealtimeGuard::isInsideSection() noexcept
+{
+    return sectionDepth > 0;
+}
+
+void RealtimeGuard::setHandler(Handler h) noexcept
+{
+    handler = h;
+}
+
+void RealtimeGuard::notify(Violation v, const char* what) noexcept
+{
+    if (sectionDepth <= 0)
+        return;
+
+    // let the handler / assertion machinery allocate without re-entering here
+    const auto saved = sectionDepth;
+    sectionDepth = 0;
+
+    if (auto h = handler.load())
+        h(v, what);
+    else
+        jassertfalse;   // heap allocation / free / lock on the audio thread
+
+    sectionDepth = saved;
+}
+
+//===========================================================================
+// replacement global allocation functions (debug only)
+#if AIRBLOOM_CHECK_RT_ALLOCATIONS
+
+void* operator new(std::size_t size)
+{
+    RealtimeGuard::notify(RealtimeGuard::Violation::allocation, "operator new");
+
+    if (auto* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    RealtimeGuard::notify(RealtimeGuard::Violation::allocation, "operator new");
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p != nullptr)
+        RealtimeGuard::notify(RealtimeGuard::Violation::deallocation, "operator delete");
+
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept                         { ::operator delete(p); }
+void operator delete(void* p, std::size_t) noexcept              { ::operator delete(p); }
+void operator delete[](void* p, std::size_t) noexcept            { ::operator delete(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept    { ::operator delete(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept  { ::operator delete(p); }
+
+#endif
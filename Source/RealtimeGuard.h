@@ -0,0 +1,40 @@
+#pragma once
+#include <juce_core/juce_core.h>
+
+/*  Debug tripwire for heap use (and locking) on the audio thread.
+
+    Put a RealtimeGuard::ScopedSection at the top of processBlock(); any
+    operator new / delete made on that thread while the section is alive
+    fires a jassert. The replacement operators only exist when
+    AIRBLOOM_CHECK_RT_ALLOCATIONS is on (debug builds by default), so a
+    release build pays nothing for this.
+
+    Anything else that can spot a violation – the malloc / mutex
+    interposers in Tools/AirBloomRtAudit.cpp – reports through notify()
+    too, and can swap the jassert for its own handler.                  */
+#ifndef AIRBLOOM_CHECK_RT_ALLOCATIONS
+ #define AIRBLOOM_CHECK_RT_ALLOCATIONS JUCE_DEBUG
+#endif
+
+struct RealtimeGuard
+{
+    class ScopedSection
+    {
+    public:
+        ScopedSection() noexcept;
+        ~ScopedSection() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedSection)
+    };
+
+    enum class Violation { allocation, deallocation, lock };
+
+    /* runs on the offending thread with the section suspended, so it may
+       allocate; `what` is a string literal naming the call            */
+    using Handler = void (*)(Violation, const char* what);
+
+    /* no-op outside a section; inside, calls the handler (default: jassert) */
+    static void notify(Violation v, const char* what) noexcept;
+    static void setHandler(Handler h) noexcept;     // nullptr → default
+    static bool isInsideSection() noexcept;
+};
@@ -0,0 +1,49 @@
+#include "ShelfCoefficientTable.h"
+
+//===========================================================================
+void ShelfCoefficientTable::build(double sampleRate, float maxShelfDb)
+{
+    jassert(sampleRate > 0.0);
+
+    for (int i = 0; i < numEntries; ++i)
+    {
+        const double bloom = (double)i / (double)(numEntries - 1);
+        auto c = makeShelf(sampleRate, bloom * (double)maxShelfDb);
+
+        jassert(c->coefficients.size() == numCoeffs);
+        std::copy_n(c->getRawCoefficients(), numCoeffs,
+            table.begin() + i * numCoeffs);
+    }
+
+    rate = sampleRate;
+}
+
+juce::dsp::IIR::Coefficients<double>::Ptr ShelfCoefficientTable::makeShelf(double sampleRate, double boostDb)
+{
+    // keep the shelf below Nyquist at low rates
+    const auto fc = juce::jmin((double)cutoffHz, sampleRate * 0.45);
+
+    return juce::dsp::IIR::Coefficients<double>::makeHighShelf(
+        sampleRate, fc, (double)shelfQ, juce::Decibels::decibelsToGain(boostDb));
+}
+
+//===========================================================================
+// audio thread: no allocation, no locks
+template <typename SampleType>
+void ShelfCoefficientTable::lookup(float bloom, SampleType* dest) const noexcept
+{
+    jassert(isBuilt());
+
+    const float pos = juce::jlimit(0.0f, 1.0f, bloom) * (float)(numEntries - 1);
+    const int   i0 = juce::jmin((int)pos, numEntries - 2);
+    const float frac = pos - (float)i0;
+
+    const double* lo = table.data() + i0 * numCoeffs;
+    const double* hi = lo + numCoeffs;
+
+    for (int k = 0; k < numCoeffs; ++k)
+        dest[k] = (SampleType)(lo[k] + (double)frac * (hi[k] - lo[k]));
+}
+
+template void ShelfCoefficientTable::lookup<float>(float, float*) const noexcept;
+template void ShelfCoefficientTable::lookup<double>(float, double*) const noexcept;
@@ -0,0 +1,37 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+
+/*  Pre-computed Bloom high-shelf coefficients.
+
+    build() runs in prepareToPlay() (it may allocate, it's off the audio
+    thread); lookup() is all the audio thread ever calls – it linearly
+    interpolates between the two nearest Bloom entries and writes the
+    five a0-normalised biquad coefficients straight into a filter state.
+    The table is kept in double and rounded on the way out, so the float
+    and double shelves share it.                                         */
+class ShelfCoefficientTable
+{
+public:
+    static constexpr int   numEntries = 257;         // Bloom 0…1 in 1/256 steps
+    static constexpr int   numCoeffs = 5;           // b0 b1 b2 a1 a2
+    static constexpr float cutoffHz = 10000.0f;
+    static constexpr float shelfQ = 0.7071f;
+
+    /* sampleRate is the rate the shelf actually runs at (i.e. after
+       oversampling), maxShelfDb is the boost at Bloom = 1.            */
+    void build(double sampleRate, float maxShelfDb);
+
+    bool   isBuilt()       const noexcept { return rate > 0.0; }
+    double getSampleRate() const noexcept { return rate; }
+
+    template <typename SampleType>
+    void lookup(float bloom, SampleType* dest) const noexcept;
+
+    /* one entry's worth: the shelf at sampleRate with boostDb (allocates) */
+    static juce::dsp::IIR::Coefficients<double>::Ptr makeShelf(double sampleRate, double boostDb);
+
+private:
+    std::array<double, (size_t)(numEntries * numCoeffs)> table{};
+    double rate = 0.0;
+};
@@ -0,0 +1,230 @@
+#pragma once
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+
+/*  Bloom soft clip:  y = tanh(drive · x)
+
+    tanh is replaced by Lambert's [7/6] continued-fraction approximant
+
+        tanh(x) ≈ x (135135 + 17325x² + 378x⁴ + x⁶)
+                    / (135135 + 62370x² + 3150x⁴ + 28x⁶)
+
+    with |x| clamped to 4.97 (the approximant reaches 1 at ≈4.9718).
+    Absolute error against std::tanh is below 1.0e-4 for every finite
+    input (worst case is in the clamped tail; below |x| = 3 it is about
+    1.1e-6, held to 1.2e-6 by AirBloomSoftClipCheck),
+    and the curve stays odd and monotonic, so nothing audible changes.
+
+    The kernel runs 8 lanes with AVX, 4 with SSE2 or NEON, and falls back
+    to the same rational in scalar code. Double blocks run the rational in
+    double, as a plain loop the compiler can vectorise. Build with
+    AIRBLOOM_SOFTCLIP_SIMD=0 to use the std::tanh reference instead.    */
+#ifndef AIRBLOOM_SOFTCLIP_SIMD
+ #define AIRBLOOM_SOFTCLIP_SIMD 1
+#endif
+
+#if AIRBLOOM_SOFTCLIP_SIMD
+ #if defined(__AVX__)
+  #include <immintrin.h>
+  #define AIRBLOOM_SOFTCLIP_AVX 1
+ #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define AIRBLOOM_SOFTCLIP_SSE 1
+ #elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+  #include <arm_neon.h>
+  #define AIRBLOOM_SOFTCLIP_NEON 1
+ #endif
+#endif
+
+class SoftClipper
+{
+public:
+    static constexpr float drive = 1.5f;      // 0 dBFS enters soft knee at ~-6 dB
+    static constexpr float maxAbsError = 1.0e-4f;
+    static constexpr float innerRange = 3.0f;           // |drive · x| below this…
+    static constexpr float maxInnerError = 1.2e-6f;     // …the error stays below this
+    static constexpr float clampX = 4.97f;
+
+    //==========================================================================
+    // juce::dsp processor interface, so it drops into the colour chain
+    void prepare(const juce::dsp::ProcessSpec&) noexcept {}
+    void reset() noexcept {}
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& ctx) noexcept
+    {
+        auto&& out = ctx.getOutputBlock();
+
+        if (ctx.usesSeparateInputAndOutputBlocks())
+            out.copyFrom(ctx.getInputBlock());
+
+        if (!ctx.isBypassed)
+            processBlock(out);
+    }
+
+    //==========================================================================
+    template <typename SampleType>
+    static void processBlock(const juce::dsp::AudioBlock<SampleType>& block) noexcept
+    {
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
+            processSamples(block.getChannelPointer(ch), block.getNumSamples());
+    }
+
+    /* in place, whole channel at once */
+    static void processSamples(float* data, size_t numSamples) noexcept
+    {
+       #if ! AIRBLOOM_SOFTCLIP_SIMD
+        for (size_t i = 0; i < numSamples; ++i)
+            data[i] = referenceSample(data[i]);
+       #else
+        size_t i = 0;
+
+       #if AIRBLOOM_SOFTCLIP_AVX
+        const auto k = Avx::constants();
+        for (; i + 8 <= numSamples; i += 8)
+            _mm256_storeu_ps(data + i, Avx::tanh(_mm256_loadu_ps(data + i), k));
+       #elif AIRBLOOM_SOFTCLIP_SSE
+        const auto k = Sse::constants();
+        for (; i + 4 <= numSamples; i += 4)
+            _mm_storeu_ps(data + i, Sse::tanh(_mm_loadu_ps(data + i), k));
+       #elif AIRBLOOM_SOFTCLIP_NEON
+        for (; i + 4 <= numSamples; i += 4)
+            vst1q_f32(data + i, Neon::tanh(vld1q_f32(data + i)));
+       #endif
+
+        for (; i < numSamples; ++i)
+            data[i] = processSample(data[i]);
+       #endif
+    }
+
+    static void processSamples(double* data, size_t numSamples) noexcept
+    {
+        for (size_t i = 0; i < numSamples; ++i)
+           #if AIRBLOOM_SOFTCLIP_SIMD
+            data[i] = processSample(data[i]);
+           #else
+            data[i] = referenceSample(data[i]);
+           #endif
+    }
+
+    /* scalar version of the vector kernel (used for the tail) */
+    static float processSample(float x) noexcept
+    {
+        const float xc = juce::jlimit(-clampX, clampX, x * drive);
+        const float x2 = xc * xc;
+        const float num = xc * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+        const float den = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+        return num / den;
+    }
+
+    static double processSample(double x) noexcept
+    {
+        const double xc = juce::jlimit(-(double)clampX, (double)clampX, x * (double)drive);
+        const double x2 = xc * xc;
+        const double num = xc * (135135.0 + x2 * (17325.0 + x2 * (378.0 + x2)));
+        const double den = 135135.0 + x2 * (62370.0 + x2 * (3150.0 + x2 * 28.0));
+        return num / den;
+    }
+
+    /* what the approximation is measured against */
+    static float referenceSample(float x) noexcept
+    {
+        return std::tanh(x * drive);
+    }
+
+    static double referenceSample(double x) noexcept
+    {
+        return std::tanh(x * (double)drive);
+    }
+
+private:
+   #if AIRBLOOM_SOFTCLIP_AVX
+    struct Avx
+    {
+        struct K { __m256 drive, lo, hi, n0, n1, n2, d1, d2, d3; };
+
+        static K constants() noexcept
+        {
+            return { _mm256_set1_ps(drive),   _mm256_set1_ps(-clampX), _mm256_set1_ps(clampX),
+                     _mm256_set1_ps(135135.0f), _mm256_set1_ps(17325.0f), _mm256_set1_ps(378.0f),
+                     _mm256_set1_ps(62370.0f), _mm256_set1_ps(3150.0f), _mm256_set1_ps(28.0f) };
+        }
+
+        static __m256 tanh(__m256 x, const K& k) noexcept
+        {
+            x = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(x, k.drive), k.lo), k.hi);
+            const __m256 x2 = _mm256_mul_ps(x, x);
+
+            __m256 num = _mm256_add_ps(k.n2, x2);
+            num = _mm256_add_ps(k.n1, _mm256_mul_ps(x2, num));
+            num = _mm256_mul_ps(x, _mm256_add_ps(k.n0, _mm256_mul_ps(x2, num)));
+
+            __m256 den = _mm256_add_ps(k.d2, _mm256_mul_ps(x2, k.d3));
+            den = _mm256_add_ps(k.d1, _mm256_mul_ps(x2, den));
+            den = _mm256_add_ps(k.n0, _mm256_mul_ps(x2, den));
+
+            return _mm256_div_ps(num, den);
+        }
+    };
+   #endif
+
+   #if AIRBLOOM_SOFTCLIP_SSE
+    struct Sse
+    {
+        struct K { __m128 drive, lo, hi, n0, n1, n2, d1, d2, d3; };
+
+        static K constants() noexcept
+        {
+            return { _mm_set1_ps(drive),   _mm_set1_ps(-clampX), _mm_set1_ps(clampX),
+                     _mm_set1_ps(135135.0f), _mm_set1_ps(17325.0f), _mm_set1_ps(378.0f),
+                     _mm_set1_ps(62370.0f), _mm_set1_ps(3150.0f), _mm_set1_ps(28.0f) };
+        }
+
+        static __m128 tanh(__m128 x, const K& k) noexcept
+        {
+            x = _mm_min_ps(_mm_max_ps(_mm_mul_ps(x, k.drive), k.lo), k.hi);
+            const __m128 x2 = _mm_mul_ps(x, x);
+
+            __m128 num = _mm_add_ps(k.n2, x2);
+            num = _mm_add_ps(k.n1, _mm_mul_ps(x2, num));
+            num = _mm_mul_ps(x, _mm_add_ps(k.n0, _mm_mul_ps(x2, num)));
+
+            __m128 den = _mm_add_ps(k.d2, _mm_mul_ps(x2, k.d3));
+            den = _mm_add_ps(k.d1, _mm_mul_ps(x2, den));
+            den = _mm_add_ps(k.n0, _mm_mul_ps(x2, den));
+
+            return _mm_div_ps(num, den);
+        }
+    };
+   #endif
+
+   #if AIRBLOOM_SOFTCLIP_NEON
+    struct Neon
+    {
+        static float32x4_t tanh(float32x4_t x) noexcept
+        {
+            x = vminq_f32(vmaxq_f32(vmulq_n_f32(x, drive), vdupq_n_f32(-clampX)),
+                          vdupq_n_f32(clampX));
+            const float32x4_t x2 = vmulq_f32(x, x);
+
+            float32x4_t num = vaddq_f32(vdupq_n_f32(378.0f), x2);
+            num = vmlaq_f32(vdupq_n_f32(17325.0f), x2, num);
+            num = vmulq_f32(x, vmlaq_f32(vdupq_n_f32(135135.0f), x2, num));
+
+            float32x4_t den = vmlaq_f32(vdupq_n_f32(3150.0f), x2, vdupq_n_f32(28.0f));
+            den = vmlaq_f32(vdupq_n_f32(62370.0f), x2, den);
+            den = vmlaq_f32(vdupq_n_f32(135135.0f), x2, den);
+
+           #if defined(__aarch64__) || defined(_M_ARM64)
+            return vdivq_f32(num, den);
+           #else
+            // ARMv7 has no divide: reciprocal estimate + two Newton steps
+            float32x4_t r = vrecpeq_f32(den);
+            r = vmulq_f32(vrecpsq_f32(den, r), r);
+            r = vmulq_f32(vrecpsq_f32(den, r), r);
+            return vmulq_f32(num, r);
+           #endif
+        }
+    };
+   #endif
+};
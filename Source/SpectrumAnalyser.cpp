@@ -0,0 +1,211 @@
+#include "SpectrumAnalyser.h"
+
+namespace
+{
+    constexpr float averaging = 0.25f;          // per frame; ≈ 130 ms at 30 frames / s
+    constexpr int   idleSliceMs = 15;           // frames come every ~33 ms
+    constexpr float repaintDb = 0.25f;          // smallest change worth a repaint
+    constexpr float shelfTop = 0.15f;           // shelf curve: maxDb here …
+    constexpr float shelfBottom = 0.85f;        //              … 0 dB here (of the height)
+}
+
+//===========================================================================
+SpectrumAnalyser::SpectrumAnalyser(MeterFeed& f) : feed(f)
+{
+    for (auto& s : slots)
+        s.fill(floorDb);
+
+    feed.setAnalysisWanted(true);
+    thread->addTimeSliceClient(this);
+}
+
+SpectrumAnalyser::~SpectrumAnalyser()
+{
+    thread->removeTimeSliceClient(this);
+    feed.setAnalysisWanted(false);
+}
+
+float SpectrumAnalyser::getPointFrequency(int point) noexcept
+{
+    return minHz * std::pow(maxHz / minHz, (float)point / (float)(numPoints - 1));
+}
+
+bool SpectrumAnalyser::getLatest(Spectrum& dest) noexcept
+{
+    if ((middle.load() & freshBit) == 0)
+        return false;
+
+    front = middle.exchange(front) & ~freshBit;
+    dest = slots[(size_t)front];
+    return true;
+}
+
+//===========================================================================
+// analyser thread
+int SpectrumAnalyser::useTimeSlice()
+{
+    if (const double rate = sampleRate.load(); rate != mappedRate)
+        mapPoints(rate);
+
+    bool any = false;
+
+    while (feed.popAnalysisFrame(fftData.data()))
+    {
+        analyseFrame();
+        any = true;
+    }
+
+    if (any)
+        publish();
+
+    return idleSliceMs;
+}
+
+void SpectrumAnalyser::mapPoints(double rate) noexcept
+{
+    mappedRate = rate;
+
+    const float binsPerHz = (float)fftSize / (float)rate;
+    const float halfStep = std::sqrt(std::pow(maxHz / minHz, 1.0f / (float)(numPoints - 1)));
+    constexpr int lastBin = fftSize / 2;
+
+    for (int p = 0; p < numPoints; ++p)
+    {
+        const float centre = getPointFrequency(p) * binsPerHz;
+        auto& b = pointBins[(size_t)p];
+
+        // each point covers the bins halfway (in log frequency) to its neighbours
+        b.first = juce::jmin(lastBin, (int)std::ceil(centre / halfStep));
+        b.last = juce::jmin(lastBin, (int)std::floor(centre * halfStep));
+        b.centre = juce::jmin((float)lastBin, centre);
+    }
+}
+
+void SpectrumAnalyser::analyseFrame() noexcept
+{
+    constexpr int numBins = fftSize / 2 + 1;
+
+    // a full-scale sine comes out at 1: N / 2 for the transform, × 0.5 for the Hann window
+    constexpr float norm = 4.0f / (float)fftSize;
+
+    window.multiplyWithWindowingTable(fftData.data(), (size_t)fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+    auto* bins = fftData.data();
+    juce::FloatVectorOperations::multiply(bins, norm, numBins);
+    juce::FloatVectorOperations::multiply(bins, bins, numBins);        // power
+
+    juce::FloatVectorOperations::multiply(power.data(), 1.0f - averaging, numBins);
+    juce::FloatVectorOperations::addWithMultiply(power.data(), bins, averaging, numBins);
+}
+
+void SpectrumAnalyser::publish() noexcept
+{
+    auto& s = slots[(size_t)back];
+
+    for (int p = 0; p < numPoints; ++p)
+    {
+        const auto& b = pointBins[(size_t)p];
+        float v;
+
+        if (b.last >= b.first)
+        {
+            v = 0.0f;
+            for (int k = b.first; k <= b.last; ++k)
+                v = juce::jmax(v, power[(size_t)k]);
+        }
+        else
+        {
+            const int k = juce::jmin((int)b.centre, fftSize / 2 - 1);
+            const float frac = b.centre - (float)k;
+            v = power[(size_t)k] + frac * (power[(size_t)k + 1] - power[(size_t)k]);
+        }
+
+        s[(size_t)p] = juce::jmax(floorDb, 10.0f * std::log10(v + 1.0e-12f));
+    }
+
+    back = middle.exchange(back | freshBit) & ~freshBit;
+}
+
+//===========================================================================
+SpectrumDisplay::SpectrumDisplay()
+{
+    spectrum.fill(SpectrumAnalyser::floorDb);
+    setInterceptsMouseClicks(false, false);
+}
+
+float SpectrumDisplay::pointX(int point) const noexcept
+{
+    // the points are log-spaced, so evenly spaced across the width
+    return (float)getWidth() * (float)point / (float)(SpectrumAnalyser::numPoints - 1);
+}
+
+void SpectrumDisplay::setSpectrum(const Spectrum& newSpectrum)
+{
+    const float dbPerPx = -SpectrumAnalyser::floorDb / (float)juce::jmax(1, getHeight());
+    const float threshold = juce::jmax(repaintDb, dbPerPx);
+
+    bool moved = false;
+    for (size_t p = 0; p < newSpectrum.size() && !moved; ++p)
+        moved = std::abs(newSpectrum[p] - spectrum[p]) > threshold;
+
+    if (!moved)
+        return;
+
+    spectrum = newSpectrum;
+    repaint();
+}
+
+void SpectrumDisplay::setShelfCurve(const Spectrum& gainDb, float maxDb)
+{
+    if (gainDb == shelfDb && maxDb == shelfMaxDb)
+        return;
+
+    shelfDb = gainDb;
+    shelfMaxDb = juce::jmax(maxDb, 0.01f);
+    rebuildShelfPath();
+    repaint();
+}
+
+void SpectrumDisplay::resized()
+{
+    rebuildShelfPath();
+}
+
+void SpectrumDisplay::rebuildShelfPath()
+{
+    const float h = (float)getHeight();
+    const float y0 = h * shelfBottom, yMax = h * shelfTop;
+
+    shelfPath.clear();
+
+    for (int p = 0; p < SpectrumAnalyser::numPoints; ++p)
+    {
+        const float y = juce::jmap(juce::jlimit(0.0f, shelfMaxDb, shelfDb[(size_t)p]),
+                                   0.0f, shelfMaxDb, y0, yMax);
+        if (p == 0)
+            shelfPath.startNewSubPath(pointX(p), y);
+        else
+            shelfPath.lineTo(pointX(p), y);
+    }
+}
+
+void SpectrumDisplay::paint(juce::Graphics& g)
+{
+    const float h = (float)getHeight();
+
+    juce::Path fill;
+    fill.startNewSubPath(0.0f, h);
+
+    for (int p = 0; p < SpectrumAnalyser::numPoints; ++p)
+        fill.lineTo(pointX(p), juce::jmap(spectrum[(size_t)p], SpectrumAnalyser::floorDb, 0.0f, h, 0.0f));
+
+    fill.lineTo((float)getWidth(), h);
+    fill.closeSubPath();
+
+    g.setColour(juce::Colours::white.withAlpha(0.12f));
+    g.fillPath(fill);
+
+    g.setColour(juce::Colours::orange.withAlpha(0.7f));
+    g.strokePath(shelfPath, juce::PathStrokeType(1.5f));
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <JuceHeader.h>
+#include "MeterFeed.h"
+
+/*  The output spectrum behind the Bloom knob.
+
+    The FFT runs on one background thread (a juce::TimeSliceThread shared
+    by every open editor, in every instance), never on the message
+    thread. Each slice drains the analysis frames MeterFeed collected,
+    Hann-windows and transforms them, averages the power per bin and
+    reduces it to numPoints log-spaced points, 20 Hz … 20 kHz. The result
+    is handed to the message thread through a triple buffer: neither side
+    waits for the other, and the editor's timer only sees a spectrum when
+    a new one has been published.                                        */
+class SpectrumAnalyser : private juce::TimeSliceClient
+{
+public:
+    static constexpr int   fftOrder = 11;
+    static constexpr int   fftSize = 1 << fftOrder;
+    static constexpr int   numPoints = 128;
+    static constexpr float minHz = 20.0f;
+    static constexpr float maxHz = 20000.0f;
+    static constexpr float floorDb = -90.0f;
+
+    static_assert(fftSize == MeterFeed::analysisFrameSize, "one analysis frame per FFT");
+
+    using Spectrum = std::array<float, numPoints>;  // dB, full-scale sine = 0
+
+    /* starts asking `feed` for analysis audio, and stops again when destroyed */
+    explicit SpectrumAnalyser(MeterFeed& feed);
+    ~SpectrumAnalyser() override;
+
+    //==========================================================================
+    // message thread
+    void setSampleRate(double newRate) noexcept   { sampleRate = newRate; }
+
+    /* false if nothing new was published since the last call */
+    bool getLatest(Spectrum& dest) noexcept;
+
+    static float getPointFrequency(int point) noexcept;
+
+private:
+    struct AnalyserThread : public juce::TimeSliceThread
+    {
+        AnalyserThread() : juce::TimeSliceThread("AirBloom analyser") { startThread(); }
+    };
+
+    /* each point reads bins [first, last], or interpolates at `centre`
+       when it falls between two of them */
+    struct PointBins { int first = 0, last = -1; float centre = 0.0f; };
+
+    int  useTimeSlice() override;
+    void mapPoints(double rate) noexcept;
+    void analyseFrame() noexcept;
+    void publish() noexcept;
+
+    MeterFeed& feed;
+
+    // — analyser thread only —
+    juce::dsp::FFT                      fft{ fftOrder };
+    juce::dsp::WindowingFunction<float> window{ (size_t)fftSize, juce::dsp::WindowingFunction<float>::hann, false };
+    std::array<float, 2 * fftSize>      fftData{};
+    std::array<float, fftSize / 2 + 1>  power{};          // averaged, per bin
+    std::array<PointBins, numPoints>    pointBins;
+    double mappedRate = 0.0;
+
+    // — triple buffer: back written here, front read on the message thread,
+    //   middle swapped between them with freshBit set when it's new —
+    static constexpr int freshBit = 4;
+    std::array<Spectrum, 3> slots{};
+    std::atomic<int> middle{ 1 };
+    int back = 0, front = 2;
+
+    std::atomic<double> sampleRate{ 44100.0 };
+
+    // one thread for every analyser in the process
+    juce::SharedResourcePointer<AnalyserThread> thread;
+
+    JUCE_DECLARE_NON_COPYABLE(SpectrumAnalyser)
+};
+
+/*  Draws a SpectrumAnalyser spectrum, filled, with the Bloom shelf's
+    response on top. Doesn't take mouse clicks – it sits behind the knob.
+
+    A new spectrum only repaints when some point has moved visibly, and the
+    shelf path is only rebuilt when the curve or the size changes.        */
+class SpectrumDisplay : public juce::Component
+{
+public:
+    using Spectrum = SpectrumAnalyser::Spectrum;
+
+    SpectrumDisplay();
+
+    void setSpectrum(const Spectrum& newSpectrum);
+
+    /* gain in dB at each SpectrumAnalyser point, drawn 0 … maxDb */
+    void setShelfCurve(const Spectrum& gainDb, float maxDb);
+
+    void paint(juce::Graphics&) override;
+    void resized() override;
+
+private:
+    float pointX(int point) const noexcept;
+    void  rebuildShelfPath();
+
+    Spectrum   spectrum, shelfDb{};
+    float      shelfMaxDb = 1.0f;
+    juce::Path shelfPath;
+};
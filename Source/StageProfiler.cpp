@@ -0,0 +1,145 @@
+#include "StageProfiler.h"
+
+namespace
+{
+    // single writer: a plain load / store, no locked read-modify-write
+    void bump(std::atomic<juce::uint32>& a) noexcept
+    {
+        a.store(a.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+//===========================================================================
+StageProfiler::StageProfiler() noexcept
+    : nsPerTick(1.0e9 / (double)juce::Time::getHighResolutionTicksPerSecond())
+{
+}
+
+const char* StageProfiler::getStageName(int stage) noexcept
+{
+    switch (stage)
+    {
+        case inputGain: return "input gain";
+        case lowCut:    return "low cut";
+        case colour:    return "colour";
+        case reverb:    return "reverb";
+        case mix:       return "mix";
+        default:        return "?";
+    }
+}
+
+// quarter octaves: the top bit picks the octave, the next two the quarter
+int StageProfiler::binFor(juce::uint64 ns) noexcept
+{
+    if (ns < (juce::uint64)binsPerOctave)
+        return (int)ns;
+
+    const auto n = (juce::uint32)juce::jmin(ns, (juce::uint64)0xffffffffu);
+    const int msb = juce::findHighestSetBit(n);
+    const int quarter = (int)(n >> (msb - 2)) & (binsPerOctave - 1);
+    return juce::jmin(numBins - 1, msb * binsPerOctave + quarter);
+}
+
+double StageProfiler::binMiddle(int bin) noexcept
+{
+    if (bin < binsPerOctave)
+        return (double)bin;
+
+    const int msb = bin / binsPerOctave;
+    const double step = std::ldexp(1.0, msb - 2);
+    return ((double)(binsPerOctave + bin % binsPerOctave) + 0.5) * step;
+}
+
+//===========================================================================
+// readers
+StageProfiler::Summary StageProfiler::getSummary(int stage) const noexcept
+{
+    Summary s;
+
+    if (!juce::isPositiveAndBelow(stage, (int)numStages))
+        return s;
+
+    const auto& h = stages[(size_t)stage];
+
+    std::array<juce::uint32, numBins> bins;
+    juce::uint64 total = 0;
+
+    for (int b = 0; b < numBins; ++b)
+        total += (bins[(size_t)b] = h.bins[(size_t)b].load(std::memory_order_relaxed));
+
+    if (total == 0)
+        return s;
+
+    s.count = total;
+    s.max = (double)h.maxNs.load(std::memory_order_relaxed) * 1.0e-3;
+
+    auto percentile = [&](double q)
+    {
+        const auto rank = (juce::uint64)std::ceil(q * (double)total);
+        juce::uint64 seen = 0;
+
+        for (int b = 0; b < numBins; ++b)
+            if ((seen += bins[(size_t)b]) >= rank)
+                return juce::jmin(binMiddle(b) * 1.0e-3, s.max);
+
+        return s.max;
+    };
+
+    s.p50 = percentile(0.50);
+    s.p99 = percentile(0.99);
+    return s;
+}
+
+//===========================================================================
+// audio thread
+void StageProfiler::record(int stage, juce::int64 ticks) noexcept
+{
+    // a reset asked for by a reader is done here, by the only writer
+    if (const int requests = resetRequests.load(std::memory_order_relaxed); requests != resetsDone)
+    {
+        resetsDone = requests;
+
+        for (auto& h : stages)
+        {
+            for (auto& b : h.bins)
+                b.store(0, std::memory_order_relaxed);
+
+            h.maxNs.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    auto& h = stages[(size_t)stage];
+    const auto ns = (juce::uint64)juce::jmax(0.0, (double)ticks * nsPerTick);
+
+    bump(h.bins[(size_t)binFor(ns)]);
+
+    if (ns > h.maxNs.load(std::memory_order_relaxed))
+        h.maxNs.store(ns, std::memory_order_relaxed);
+}
+
+StageProfiler::Laps::Laps(StageProfiler* p) noexcept
+    : profiler(p),
+      last(p != nullptr ? juce::Time::getHighResolutionTicks() : 0)
+{
+}
+
+StageProfiler::Laps::~Laps() noexcept
+{
+    if (profiler == nullptr)
+        return;
+
+    for (int s = 0; s < numStages; ++s)
+        if ((used & (1u << s)) != 0)
+            profiler->record(s, ticks[(size_t)s]);
+}
+
+void StageProfiler::Laps::lap(Stage s) noexcept
+{
+    if (profiler == nullptr)
+        return;
+
+    const auto now = juce::Time::getHighResolutionTicks();
+    ticks[(size_t)s] += now - last;
+    used |= 1u << s;
+    last = now;
+}
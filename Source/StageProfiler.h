@@ -0,0 +1,101 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+
+/*  Where the time goes inside AirBloomEngine::process(): how long each
+    stage of the chain takes, per engine chunk, as a histogram per stage
+    that the editor's diagnostics panel and the tools read p50 / p99 /
+    max from.
+
+    The engine times its stages with AIRBLOOM_PROFILE_LAPS / _LAP, which
+    only exist when AIRBLOOM_PROFILE_STAGES is on (off by default; the
+    CMake option of the same name turns it on). Off, they expand to
+    nothing and the engine reads no clocks at all.
+
+    The audio thread is the only writer: each chunk costs one
+    high-resolution clock read per stage, and a bin count and maximum
+    updated with relaxed stores per stage that ran. Readers on any other
+    thread never block it, and may see a chunk half recorded – fine for
+    statistics. The histogram
+    bins are a quarter octave wide (≈ 19 %), from 1 ns up to ~4 s.        */
+#ifndef AIRBLOOM_PROFILE_STAGES
+ #define AIRBLOOM_PROFILE_STAGES 0
+#endif
+
+class StageProfiler
+{
+public:
+    enum Stage { inputGain, lowCut, colour, reverb, mix, numStages };
+
+    static const char* getStageName(int stage) noexcept;
+
+    struct Summary
+    {
+        juce::uint64 count = 0;             // chunks the stage ran in
+        double p50 = 0.0, p99 = 0.0, max = 0.0;   // microseconds
+    };
+
+    StageProfiler() noexcept;
+
+    //==========================================================================
+    // any thread
+    Summary getSummary(int stage) const noexcept;
+
+    /* starts the figures again from the next chunk the audio thread runs */
+    void reset() noexcept                       { ++resetRequests; }
+
+    //==========================================================================
+    // audio thread
+    void record(int stage, juce::int64 ticks) noexcept;
+
+    /* times consecutive stages of one chunk: lap(s) charges the time since
+       the last lap (or since construction) to s, and the totals are
+       recorded when it goes out of scope. Stages that never lapped aren't
+       recorded – a low cut that's switched off doesn't count as 0 µs.   */
+    class Laps
+    {
+    public:
+        explicit Laps(StageProfiler* p) noexcept;
+        ~Laps() noexcept;
+
+        void lap(Stage s) noexcept;
+
+    private:
+        StageProfiler* profiler;
+        juce::int64 last = 0;
+        std::array<juce::int64, numStages> ticks{};
+        unsigned used = 0;
+
+        JUCE_DECLARE_NON_COPYABLE(Laps)
+    };
+
+private:
+    static constexpr int binsPerOctave = 4;
+    static constexpr int numBins = 32 * binsPerOctave;
+
+    static int    binFor(juce::uint64 ns) noexcept;
+    static double binMiddle(int bin) noexcept;
+
+    struct Histogram
+    {
+        std::array<std::atomic<juce::uint32>, numBins> bins{};
+        std::atomic<juce::uint64> maxNs{ 0 };
+    };
+
+    std::array<Histogram, numStages> stages;
+    double nsPerTick = 1.0;
+
+    std::atomic<int> resetRequests{ 0 };
+    int resetsDone = 0;                     // audio thread
+
+    JUCE_DECLARE_NON_COPYABLE(StageProfiler)
+};
+
+#if AIRBLOOM_PROFILE_STAGES
+ #define AIRBLOOM_PROFILE_LAPS(profiler)  StageProfiler::Laps stageLaps{ profiler }
+ #define AIRBLOOM_PROFILE_LAP(stage)      stageLaps.lap(StageProfiler::stage)
+#else
+ #define AIRBLOOM_PROFILE_LAPS(profiler)
+ #define AIRBLOOM_PROFILE_LAP(stage)
+#endif
@@ -0,0 +1,100 @@
+#include "StateCodec.h"
+
+namespace
+{
+    constexpr char magic[4] = { 'A', 'B', 's', 't' };
+}
+
+//===========================================================================
+StateCodec::StateCodec(const juce::StringArray& parameterIDs)
+{
+    for (const auto& id : parameterIDs)
+    {
+        const auto h = hashID(id);
+        jassert(std::find(hashes.begin(), hashes.end(), h) == hashes.end());   // two IDs, one hash
+        hashes.push_back(h);
+    }
+}
+
+// FNV-1a over the UTF-8 bytes – fixed here, so it can't change under us
+juce::uint32 StateCodec::hashID(const juce::String& parameterID) noexcept
+{
+    juce::uint32 h = 2166136261u;
+
+    for (auto* p = parameterID.toRawUTF8(); *p != 0; ++p)
+        h = (h ^ (juce::uint8)*p) * 16777619u;
+
+    return h;
+}
+
+bool StateCodec::isBinaryState(const void* data, size_t size) noexcept
+{
+    return data != nullptr && size >= headerSize && std::memcmp(data, magic, sizeof(magic)) == 0;
+}
+
+int StateCodec::indexOf(juce::uint32 hash, int expected) const noexcept
+{
+    // same layout as when it was saved: no search
+    if (juce::isPositiveAndBelow(expected, (int)hashes.size()) && hashes[(size_t)expected] == hash)
+        return expected;
+
+    const auto it = std::find(hashes.begin(), hashes.end(), hash);
+    return it != hashes.end() ? (int)(it - hashes.begin()) : -1;
+}
+
+//===========================================================================
+void StateCodec::write(const float* values, juce::MemoryBlock& dest) const
+{
+    const auto num = hashes.size();
+    dest.setSize(headerSize + num * entrySize, false);
+
+    auto* d = static_cast<char*>(dest.getData());
+    std::memcpy(d, magic, sizeof(magic));
+
+    const auto version = juce::ByteOrder::swapIfBigEndian((juce::uint16)currentVersion);
+    const auto count = juce::ByteOrder::swapIfBigEndian((juce::uint16)num);
+    std::memcpy(d + 4, &version, 2);
+    std::memcpy(d + 6, &count, 2);
+    d += headerSize;
+
+    for (size_t i = 0; i < num; ++i, d += entrySize)
+    {
+        const auto h = juce::ByteOrder::swapIfBigEndian(hashes[i]);
+        juce::uint32 bits;
+        std::memcpy(&bits, values + i, 4);
+        bits = juce::ByteOrder::swapIfBigEndian(bits);
+
+        std::memcpy(d, &h, 4);
+        std::memcpy(d + 4, &bits, 4);
+    }
+}
+
+bool StateCodec::read(const void* data, size_t size, float* values, bool* found) const
+{
+    if (!isBinaryState(data, size))
+        return false;
+
+    auto* s = static_cast<const char*>(data);
+    const int version = juce::ByteOrder::littleEndianShort(s + 4);
+    const size_t num = (size_t)juce::ByteOrder::littleEndianShort(s + 6);
+
+    if (version < 1 || version > currentVersion || size < headerSize + num * entrySize)
+        return false;
+
+    std::fill_n(found, hashes.size(), false);
+    s += headerSize;
+
+    for (size_t i = 0; i < num; ++i, s += entrySize)
+    {
+        const int index = indexOf(juce::ByteOrder::littleEndianInt(s), (int)i);
+
+        if (index < 0)
+            continue;                       // a parameter this build doesn't have
+
+        const auto bits = juce::ByteOrder::littleEndianInt(s + 4);
+        std::memcpy(values + index, &bits, 4);
+        found[index] = true;
+    }
+
+    return true;
+}
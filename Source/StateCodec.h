@@ -0,0 +1,53 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <vector>
+
+/*  The plug-in's state as hosts store it: every parameter's raw value,
+    written straight out as binary, without going through a ValueTree or
+    XML text. Hosts ask for it on every undo snapshot and autosave.
+
+    Layout (little-endian), version 1:
+
+        char[4]  "ABst"
+        uint16   version
+        uint16   number of values
+        { uint32 FNV-1a hash of the parameter ID, float32 value } × number
+
+    Values are found by ID hash. That way a state from a build with
+    parameters added, removed or reordered still loads what it can. When
+    the stored order is the current one (the usual case), each value goes
+    straight to its index. States without the magic aren't binary at all:
+    they are the XML that earlier versions wrote, and the caller migrates
+    those itself (see AirBloomAudioProcessor::setStateInformation).
+
+    Version goes up only when this layout changes; a state with a newer
+    version than this build knows isn't read.                           */
+class StateCodec
+{
+public:
+    static constexpr int currentVersion = 1;
+
+    /* the parameters, in the order values are passed to write() / read() */
+    explicit StateCodec(const juce::StringArray& parameterIDs);
+
+    int getNumParameters() const noexcept { return (int)hashes.size(); }
+
+    /* values[i] is parameter i's raw (not normalised) value */
+    void write(const float* values, juce::MemoryBlock& dest) const;
+
+    /* fills values[i] and sets found[i] for each parameter the state has;
+       false (and nothing touched) if it isn't a state this build can read */
+    bool read(const void* data, size_t size, float* values, bool* found) const;
+
+    /* starts with the magic – otherwise it's an older XML state */
+    static bool isBinaryState(const void* data, size_t size) noexcept;
+
+    static juce::uint32 hashID(const juce::String& parameterID) noexcept;
+
+private:
+    static constexpr size_t headerSize = 8, entrySize = 8;
+
+    int indexOf(juce::uint32 hash, int expected) const noexcept;
+
+    std::vector<juce::uint32> hashes;
+};
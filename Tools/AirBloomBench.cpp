@@ -0,0 +1,835 @@
+/*  AirBloomBench – benchmark suite for the AirBloom DSP.
+
+    Console only, nothing here ships in the plug-in. Run a Release build:
+
+        AirBloomBench                        every stage, full sweep
+        AirBloomBench softclip               only cases whose name contains "softclip"
+        AirBloomBench --quick                48 kHz, blocks 64 / 512 / 4096 only
+        AirBloomBench --json results.json    also write the results as JSON
+        AirBloomBench --min-time 0.5         seconds per case (default 0.05)
+
+    Each stage of the processBlock chain is timed on its own: input gain
+    ramp, low cut, shelf, drive, soft clip, oversampling up / down (every
+    factor × filter), the reverb (JUCE's and the FDN at each order), the
+    mixes (multi-pass vs FusedMixer). The low cut and shelf run on
+    MultichannelBiquad, as the engine and ColourPath do; variant
+    "duplicator" times JUCE's ProcessorDuplicator next to them. The
+    whole AirBloomEngine is timed
+    end to end at every oversampling factor, at 4× across engine chunk
+    sizes, and at 4× on mono tracks. The low cut, soft clip, FDN and
+    engine cases also run in double (variant "double", or a "_double"
+    suffix), so the cost of 64-bit processing can be read off next to
+    the float numbers. 5.1 and
+    7.1.4 beds get their own cases (lowcut_bed, reverb_bed, engine_bed).
+    state_save / state_restore time the host state round trip, XML
+    against the binary StateCodec, per call.
+    The sweep covers block sizes 16…4096 and sample rates 44.1…192 kHz,
+    stereo unless the variant names a channel count.
+
+    Cases are named  stage[/variant]/rate/block , as Google Benchmark
+    would. Reported: ns per sample (per channel), and the realtime factor
+    (seconds of audio processed per second). Stages whose state
+    would run away when fed their own output (shelf, drive, reverb,
+    end to end) read a fresh copy of the input each call, and that copy
+    is part of the time.                                                */
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include "AirBloomEngine.h"
+#include "FusedMixer.h"
+#include "FdnReverb.h"
+#include "MultichannelBiquad.h"
+#include "ShelfCoefficientTable.h"
+#include "SoftClipKernel.h"
+#include "OversamplingMode.h"
+#include "StateCodec.h"
+
+namespace
+{
+    //==========================================================================
+    struct Settings
+    {
+        juce::String filter;
+        juce::File   json;
+        double minSeconds = 0.05;
+        bool   quick = false;
+    };
+
+    struct Result
+    {
+        double nsPerSample = 0.0;
+        juce::int64 iterations = 0;
+    };
+
+    /* runs fn until ~minSeconds have passed, returns time per processed sample */
+    template <typename Fn>
+    Result measure(Fn&& fn, int samplesPerCall, double minSeconds)
+    {
+        for (int i = 0; i < 8; ++i)      // warm caches / branch predictors
+            fn();
+
+        juce::int64 calls = 0;
+        const auto start = juce::Time::getHighResolutionTicks();
+        juce::int64 now = start;
+
+        do
+        {
+            for (int i = 0; i < 16; ++i)
+                fn();
+
+            calls += 16;
+            now = juce::Time::getHighResolutionTicks();
+        }
+        while (juce::Time::highResolutionTicksToSeconds(now - start) < minSeconds);
+
+        const double secs = juce::Time::highResolutionTicksToSeconds(now - start);
+        return { secs * 1.0e9 / ((double)calls * (double)samplesPerCall), calls };
+    }
+
+    template <typename SampleType>
+    void fillNoise(juce::AudioBuffer<SampleType>& b, juce::Random& r)
+    {
+        for (int ch = 0; ch < b.getNumChannels(); ++ch)
+            for (int i = 0; i < b.getNumSamples(); ++i)
+                b.setSample(ch, i, (SampleType)((r.nextFloat() * 2.0f - 1.0f) * 0.5f));
+    }
+
+    template <typename SampleType>
+    juce::String precisionSuffix() { return sizeof(SampleType) == sizeof(double) ? "_double" : ""; }
+
+    //==========================================================================
+    // Collects results, prints them as they come, writes JSON at the end.
+    class Suite
+    {
+    public:
+        static constexpr int numChannels = 2;
+
+        explicit Suite(const Settings& s) : settings(s) {}
+
+        const juce::Array<double>& sampleRates() const { return rates; }
+        const juce::Array<int>&    blockSizes() const  { return blocks; }
+
+        /* makeCase(sampleRate, blockSize) returns the callable to time;
+           numCh is how many channels it processes */
+        template <typename MakeCase>
+        void run(const juce::String& stage, const juce::String& variant, MakeCase&& makeCase,
+                 int numCh = numChannels)
+        {
+            for (double sr : rates)
+                for (int bs : blocks)
+                {
+                    const auto name = stage + (variant.isNotEmpty() ? "/" + variant : juce::String())
+                                    + "/" + juce::String((int)sr) + "/" + juce::String(bs);
+
+                    if (settings.filter.isNotEmpty() && !name.contains(settings.filter))
+                        continue;
+
+                    auto fn = makeCase(sr, bs);
+                    const auto r = measure(fn, numCh * bs, settings.minSeconds);
+                    report(name, stage, variant, sr, bs, numCh, r);
+                }
+        }
+
+        /* one case with no rate or block size: fn is timed per call */
+        template <typename Fn>
+        void runCalls(const juce::String& stage, const juce::String& variant, Fn&& fn, size_t bytes)
+        {
+            const auto name = stage + "/" + variant;
+
+            if (settings.filter.isNotEmpty() && !name.contains(settings.filter))
+                return;
+
+            const auto r = measure(fn, 1, settings.minSeconds);
+
+            std::printf("%-44s %10.1f ns/call   %8d bytes\n", name.toRawUTF8(), r.nsPerSample, (int)bytes);
+            std::fflush(stdout);
+
+            auto* e = new juce::DynamicObject();
+            e->setProperty("name", name);
+            e->setProperty("stage", stage);
+            e->setProperty("variant", variant);
+            e->setProperty("iterations", r.iterations);
+            e->setProperty("ns_per_call", r.nsPerSample);
+            e->setProperty("bytes", (int)bytes);
+            entries.append(juce::var(e));
+        }
+
+        bool writeJson() const
+        {
+            if (settings.json == juce::File())
+                return true;
+
+            auto* context = new juce::DynamicObject();
+            context->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+            context->setProperty("host", juce::SystemStats::getComputerName());
+            context->setProperty("cpu", juce::SystemStats::getCpuModel());
+            context->setProperty("num_cpus", juce::SystemStats::getNumCpus());
+            context->setProperty("juce_version", juce::SystemStats::getJUCEVersion());
+           #if JUCE_DEBUG
+            context->setProperty("build", "debug");
+           #else
+            context->setProperty("build", "release");
+           #endif
+
+            auto* root = new juce::DynamicObject();
+            root->setProperty("context", juce::var(context));
+            root->setProperty("benchmarks", entries);
+
+            return settings.json.replaceWithText(juce::JSON::toString(juce::var(root)));
+        }
+
+    private:
+        void report(const juce::String& name, const juce::String& stage, const juce::String& variant,
+                    double sr, int bs, int numCh, const Result& r)
+        {
+            // seconds of (stereo, or numCh-channel) audio per second of CPU
+            const double realtime = 1.0e9 / (r.nsPerSample * numCh * sr);
+
+            std::printf("%-44s %10.3f ns/sample %10.1fx realtime\n",
+                        name.toRawUTF8(), r.nsPerSample, realtime);
+            std::fflush(stdout);
+
+            auto* e = new juce::DynamicObject();
+            e->setProperty("name", name);
+            e->setProperty("stage", stage);
+            e->setProperty("variant", variant);
+            e->setProperty("sample_rate", sr);
+            e->setProperty("block_size", bs);
+            e->setProperty("channels", numCh);
+            e->setProperty("iterations", r.iterations);
+            e->setProperty("ns_per_sample", r.nsPerSample);
+            e->setProperty("realtime_factor", realtime);
+            entries.append(juce::var(e));
+        }
+
+        const Settings& settings;
+        juce::Array<double> rates = settings.quick ? juce::Array<double>{ 48000.0 }
+                                                   : juce::Array<double>{ 44100.0, 48000.0, 96000.0, 192000.0 };
+        juce::Array<int> blocks = settings.quick ? juce::Array<int>{ 64, 512, 4096 }
+                                                 : juce::Array<int>{ 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+        juce::var entries{ juce::Array<juce::var>() };
+    };
+
+    //==========================================================================
+    // Buffers shared by most cases: noise in `source`, scratch in `work`.
+    template <typename SampleType>
+    struct BasicSignal
+    {
+        explicit BasicSignal(int numSmp, int numCh = Suite::numChannels)
+        {
+            juce::Random r(1234);
+            source.setSize(numCh, numSmp);
+            work.setSize(numCh, numSmp);
+            fillNoise(source, r);
+            refresh();
+        }
+
+        void refresh()
+        {
+            for (int ch = 0; ch < source.getNumChannels(); ++ch)
+                work.copyFrom(ch, 0, source, ch, 0, source.getNumSamples());
+        }
+
+        juce::dsp::AudioBlock<SampleType> in()  { return juce::dsp::AudioBlock<SampleType>(source); }
+        juce::dsp::AudioBlock<SampleType> out() { return juce::dsp::AudioBlock<SampleType>(work); }
+
+        juce::AudioBuffer<SampleType> source, work;
+    };
+
+    using Signal = BasicSignal<float>;
+
+    juce::dsp::ProcessSpec specFor(double sr, int bs, int numCh = Suite::numChannels)
+    {
+        return { sr, (juce::uint32)bs, (juce::uint32)numCh };
+    }
+
+    template <typename SampleType = float>
+    using Biquad = juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<SampleType>,
+                                               juce::dsp::IIR::Coefficients<SampleType>>;
+
+    //==========================================================================
+    void benchGainRamp(Suite& suite)
+    {
+        suite.run("gain_ramp", {}, [](double, int bs)
+        {
+            auto sig = std::make_shared<Signal>(bs);
+            auto up = std::make_shared<bool>(true);
+
+            return [sig, up, bs]
+            {
+                // alternate directions so the level stays put
+                const float from = *up ? 0.8f : 1.25f, to = *up ? 1.25f : 0.8f;
+                for (int ch = 0; ch < Suite::numChannels; ++ch)
+                    sig->work.applyGainRamp(ch, 0, bs, from, to);
+                *up = !*up;
+            };
+        });
+    }
+
+    // the engine's low cut is a MultichannelBiquad; ProcessorDuplicator
+    // (one scalar IIR::Filter per channel) is timed alongside for comparison
+    template <typename SampleType>
+    void benchLowCut(Suite& suite)
+    {
+        const auto precision = precisionSuffix<SampleType>().substring(1);
+
+        suite.run("lowcut", precision, [](double sr, int bs)
+        {
+            auto sig = std::make_shared<BasicSignal<SampleType>>(bs);
+            auto hpf = std::make_shared<MultichannelBiquad<SampleType>>();
+            hpf->prepare(specFor(sr, bs));
+            hpf->setCoefficients(*juce::dsp::IIR::Coefficients<SampleType>::makeHighPass(
+                sr, SampleType(100), SampleType(0.7071)));
+
+            return [sig, hpf]
+            {
+                auto block = sig->out();
+                hpf->process(juce::dsp::ProcessContextReplacing<SampleType>(block));
+            };
+        });
+
+        suite.run("lowcut", "duplicator" + precisionSuffix<SampleType>(), [](double sr, int bs)
+        {
+            auto sig = std::make_shared<BasicSignal<SampleType>>(bs);
+            auto hpf = std::make_shared<Biquad<SampleType>>();
+            hpf->prepare(specFor(sr, bs));
+            *hpf->state = *juce::dsp::IIR::Coefficients<SampleType>::makeHighPass(
+                sr, SampleType(100), SampleType(0.7071));
+
+            return [sig, hpf]
+            {
+                auto block = sig->out();
+                hpf->process(juce::dsp::ProcessContextReplacing<SampleType>(block));
+            };
+        });
+    }
+
+    float* rawCoefficients(MultichannelBiquad<float>& f) { return f.getRawCoefficients(); }
+    float* rawCoefficients(Biquad<>& f)                  { return f.state->getRawCoefficients(); }
+
+    // the shelf as ColourPath runs it: a MultichannelBiquad, its
+    // coefficients written in place from the table once per 32-sample
+    // sub-block while Bloom moves. Variant "duplicator" is the same with
+    // ProcessorDuplicator, for comparison
+    template <typename Filter>
+    void benchShelf(Suite& suite, const juce::String& variant)
+    {
+        suite.run("shelf", variant, [](double sr, int bs)
+        {
+            struct Fixture
+            {
+                Signal sig;
+                ShelfCoefficientTable table;
+                Filter shelf;
+                float bloom = 0.0f;
+
+                Fixture(double sr, int bs) : sig(bs)
+                {
+                    table.build(sr, 48.0f);
+                    shelf.prepare(specFor(sr, bs));
+                    table.lookup(bloom, rawCoefficients(shelf));
+                }
+
+                void operator()()
+                {
+                    sig.refresh();
+                    auto block = sig.out();
+                    const int n = (int)block.getNumSamples();
+
+                    for (int pos = 0; pos < n; pos += 32)
+                    {
+                        const int len = juce::jmin(32, n - pos);
+                        bloom = bloom >= 1.0f ? 0.0f : bloom + 0.001f;
+                        table.lookup(bloom, rawCoefficients(shelf));
+
+                        auto sub = block.getSubBlock((size_t)pos, (size_t)len);
+                        shelf.process(juce::dsp::ProcessContextReplacing<float>(sub));
+                    }
+                }
+            };
+
+            auto f = std::make_shared<Fixture>(sr, bs);
+            return [f] { (*f)(); };
+        });
+    }
+
+    void benchDrive(Suite& suite)
+    {
+        suite.run("drive", {}, [](double sr, int bs)
+        {
+            auto sig = std::make_shared<Signal>(bs);
+            auto gain = std::make_shared<juce::dsp::Gain<float>>();
+            gain->prepare(specFor(sr, bs));
+            gain->setRampDurationSeconds(0.05);
+            gain->setGainDecibels(12.0f);
+
+            auto up = std::make_shared<bool>(true);
+
+            return [sig, gain, up]
+            {
+                gain->setGainDecibels(*up ? 12.0f : 11.0f);     // keep it ramping
+                *up = !*up;
+
+                auto in = sig->in();
+                auto out = sig->out();
+                gain->process(juce::dsp::ProcessContextNonReplacing<float>(in, out));
+            };
+        });
+    }
+
+    template <typename SampleType>
+    void benchSoftClip(Suite& suite)
+    {
+        suite.run("softclip", precisionSuffix<SampleType>().substring(1), [](double, int bs)
+        {
+            auto sig = std::make_shared<BasicSignal<SampleType>>(bs);
+            return [sig] { SoftClipper::processBlock(sig->out()); };
+        });
+    }
+
+    //==========================================================================
+    juce::String variantName(OversamplingMode m)
+    {
+        const char* filters[] = { "standard", "linear", "lowlatency" };
+        return juce::String(m.getFactor()) + "x_" + filters[(int)m.filter];
+    }
+
+    void benchOversampling(Suite& suite)
+    {
+        for (int f = 1; f < OversamplingMode::numFactors; ++f)
+            for (int filt = 0; filt < OversamplingMode::numFilters; ++filt)
+            {
+                const OversamplingMode mode{ f, (OversamplingMode::Filter)filt };
+
+                for (bool up : { true, false })
+                {
+                    suite.run(up ? "oversample_up" : "oversample_down", variantName(mode),
+                              [mode, up](double, int bs)
+                    {
+                        auto sig = std::make_shared<Signal>(bs);
+                        std::shared_ptr<juce::dsp::Oversampling<float>> os(
+                            mode.createOversampler<float>((size_t)Suite::numChannels).release());
+                        os->initProcessing((size_t)bs);
+
+                        auto in = sig->in();
+                        os->processSamplesUp(in);            // something for "down" to read
+
+                        return std::function<void()>([sig, os, up]
+                        {
+                            if (up)
+                            {
+                                auto in = sig->in();
+                                os->processSamplesUp(in);
+                            }
+                            else
+                            {
+                                auto out = sig->out();
+                                os->processSamplesDown(out);
+                            }
+                        });
+                    });
+                }
+            }
+    }
+
+    //==========================================================================
+    template <typename SampleType>
+    void benchFdn(Suite& suite, int order)
+    {
+        suite.run("reverb", "fdn" + juce::String(order) + precisionSuffix<SampleType>(),
+                  [order](double sr, int bs)
+        {
+            auto sig = std::make_shared<BasicSignal<SampleType>>(bs);
+            auto rev = std::make_shared<FdnReverb<SampleType>>();
+
+            FdnReverbBase::Parameters p;
+            p.order = order;
+            rev->setParameters(p);
+            rev->prepare(specFor(sr, bs));
+
+            return [sig, rev]
+            {
+                sig->refresh();
+                auto block = sig->out();
+                rev->process(juce::dsp::ProcessContextReplacing<SampleType>(block));
+            };
+        });
+    }
+
+    void benchReverb(Suite& suite)
+    {
+        suite.run("reverb", "juce", [](double sr, int bs)
+        {
+            auto sig = std::make_shared<Signal>(bs);
+            auto rev = std::make_shared<juce::dsp::Reverb>();
+
+            juce::Reverb::Parameters rp;
+            rp.roomSize = 0.8f;
+            rp.damping = 0.2f;
+            rp.wetLevel = 1.0f;
+            rp.dryLevel = 0.0f;
+            rev->setParameters(rp);
+            rev->prepare(specFor(sr, bs));
+
+            return [sig, rev]
+            {
+                sig->refresh();
+                auto block = sig->out();
+                rev->process(juce::dsp::ProcessContextReplacing<float>(block));
+            };
+        });
+
+        for (int order : { 4, 8, 16 })
+        {
+            benchFdn<float>(suite, order);
+            benchFdn<double>(suite, order);
+        }
+    }
+
+    //==========================================================================
+    // End-of-chain mix: the old multi-pass version against FusedMixer.
+    // The reverb itself is left out – only the memory passes around it.
+    struct MixFixture
+    {
+        MixFixture(int numCh, int numSmp, bool ramping)
+            : channels(numCh), samples(numSmp), moving(ramping)
+        {
+            juce::Random r(1234);
+            for (auto* b : { &main, &colour, &send, &wet })
+            {
+                b->setSize(numCh, numSmp);
+                fillNoise(*b, r);
+            }
+
+            bloom.prepare(48000.0, 0.05, numSmp);
+            wetSm.prepare(48000.0, 0.05, numSmp);
+            mixer.prepare(numSmp);
+        }
+
+        void restartRamps()
+        {
+            bloom.setCurrentAndTargetValue(0.3f);
+            wetSm.setCurrentAndTargetValue(0.2f);
+
+            if (moving)
+            {
+                bloom.setTargetValue(0.7f);
+                wetSm.setTargetValue(0.5f);
+            }
+
+            bloom.process(samples);
+            wetSm.process(samples);
+        }
+
+        // the chain before FusedMixer: crossfade, copy, crossfade, gain ramp
+        void multiPass()
+        {
+            restartRamps();
+
+            for (int ch = 0; ch < channels; ++ch)
+                bloom.mixInto(main.getWritePointer(ch), colour.getWritePointer(ch), samples);
+
+            for (int ch = 0; ch < channels; ++ch)
+                send.copyFrom(ch, 0, main, ch, 0, samples);
+
+            for (int ch = 0; ch < channels; ++ch)
+                wetSm.mixInto(main.getWritePointer(ch), wet.getWritePointer(ch), samples);
+
+            for (int ch = 0; ch < channels; ++ch)
+                main.applyGainRamp(ch, 0, samples, gainFrom(), gainTo());
+        }
+
+        void fused()
+        {
+            restartRamps();
+
+            const auto g = mixer.makeGainRamp(gainFrom(), gainTo(), samples);
+
+            for (int ch = 0; ch < channels; ++ch)
+                Mixer::bloomPass(main.getWritePointer(ch), colour.getReadPointer(ch),
+                                 send.getWritePointer(ch), Mixer::rampOf(bloom),
+                                 Mixer::constant(1.0f), samples);
+
+            for (int ch = 0; ch < channels; ++ch)
+                Mixer::wetPass(main.getWritePointer(ch), wet.getReadPointer(ch),
+                               Mixer::rampOf(wetSm), g, samples);
+        }
+
+        float gainFrom() const { return moving ? 0.5f : 0.56f; }
+        float gainTo()   const { return 0.56f; }
+
+        const int  channels, samples;
+        const bool moving;
+        juce::AudioBuffer<float> main, colour, send, wet;
+        using Mixer = FusedMixer<float>;
+
+        BlockSmoother<float> bloom, wetSm;
+        Mixer mixer;
+    };
+
+    void benchMix(Suite& suite)
+    {
+        for (bool fused : { false, true })
+            for (bool ramping : { false, true })
+            {
+                const juce::String variant = juce::String(fused ? "fused" : "multipass")
+                                           + (ramping ? "_moving" : "_steady");
+
+                suite.run("mix", variant, [fused, ramping](double, int bs)
+                {
+                    auto f = std::make_shared<MixFixture>(Suite::numChannels, bs, ramping);
+
+                    // keep mixed data from running off to denormals / infinity
+                    return std::function<void()>([f, fused]
+                    {
+                        if (fused) f->fused(); else f->multiPass();
+                        f->main.applyGain(0.9f);
+                    });
+                });
+            }
+    }
+
+    //==========================================================================
+    // The whole engine, as the plug-in (or AirBloomRender) runs it, with
+    // Bloom and the reverb both on.
+    template <typename SampleType>
+    void benchEngine(Suite& suite, int f, int chunk, const juce::String& stage,
+                     const juce::String& variant, int numCh = Suite::numChannels, int numInputs = 0)
+    {
+        suite.run(stage, variant + precisionSuffix<SampleType>(), [f, chunk, numCh, numInputs](double sr, int bs)
+        {
+            auto sig = std::make_shared<BasicSignal<SampleType>>(bs, numCh);
+            auto engine = std::make_shared<AirBloomEngine<SampleType>>();
+
+            AirBloomEngineBase::Parameters p;
+            p.bloom = 0.5f;
+            p.reverbWet = 0.3f;
+            p.lowCut = true;
+            p.oversample = f;
+
+            // offline, so 8× / 16× run as themselves
+            engine->setChunkSize(chunk);
+            engine->setNumInputChannels(numInputs);
+            engine->prepare(specFor(sr, bs, numCh), p.getOversamplingMode(true), p);
+            engine->setParameters(p);
+
+            return [sig, engine]
+            {
+                sig->refresh();
+                engine->process(sig->work);
+            };
+        }, numCh);
+    }
+
+    void benchEngine(Suite& suite)
+    {
+        for (int f = 0; f < OversamplingMode::numFactors; ++f)
+        {
+            const auto variant = juce::String(1 << f) + "x";
+            benchEngine<float>(suite, f, AirBloomEngineBase::defaultChunkSize, "engine", variant);
+            benchEngine<double>(suite, f, AirBloomEngineBase::defaultChunkSize, "engine", variant);
+        }
+
+        // chunk size at 4×: the host block is cut into chunks this long,
+        // so blocks above it show what cache residency buys
+        for (int chunk : { 64, 128, 256, 512, 1024, 4096 })
+            benchEngine<float>(suite, 2, chunk, "engine_chunk", "4x/" + juce::String(chunk));
+
+        // mono tracks at 4×: mono in / out, and mono in / stereo out, next
+        // to the stereo case above
+        benchEngine<float>(suite, 2, AirBloomEngineBase::defaultChunkSize, "engine_mono", "4x_mono", 1);
+        benchEngine<float>(suite, 2, AirBloomEngineBase::defaultChunkSize, "engine_mono", "4x_mono_to_stereo", 2, 1);
+    }
+
+    //==========================================================================
+    // Surround beds (5.1, 7.1.4): the low cut one channel after another
+    // (ProcessorDuplicator) against all channels in SIMD lanes
+    // (MultichannelBiquad), the FDN folded from L/R against a decorrelated
+    // tail per channel, and the engine end to end.
+    void benchBeds(Suite& suite)
+    {
+        for (int numCh : { 6, 12 })
+        {
+            const auto bed = juce::String(numCh) + "ch";
+
+            suite.run("lowcut_bed", "duplicator_" + bed, [numCh](double sr, int bs)
+            {
+                auto sig = std::make_shared<Signal>(bs, numCh);
+                auto hpf = std::make_shared<Biquad<>>();
+                hpf->prepare(specFor(sr, bs, numCh));
+                *hpf->state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(sr, 100.0f, 0.7071f);
+
+                return [sig, hpf]
+                {
+                    auto block = sig->out();
+                    hpf->process(juce::dsp::ProcessContextReplacing<float>(block));
+                };
+            }, numCh);
+
+            suite.run("lowcut_bed", "parallel_" + bed, [numCh](double sr, int bs)
+            {
+                auto sig = std::make_shared<Signal>(bs, numCh);
+                auto hpf = std::make_shared<MultichannelBiquad<float>>();
+                hpf->prepare(specFor(sr, bs, numCh));
+                hpf->setCoefficients(*juce::dsp::IIR::Coefficients<float>::makeHighPass(sr, 100.0f, 0.7071f));
+
+                return [sig, hpf]
+                {
+                    auto block = sig->out();
+                    hpf->process(juce::dsp::ProcessContextReplacing<float>(block));
+                };
+            }, numCh);
+
+            for (bool decorrelate : { false, true })
+            {
+                suite.run("reverb_bed", (decorrelate ? "fdn16_decorrelated_" : "fdn16_fold_") + bed,
+                          [numCh, decorrelate](double sr, int bs)
+                {
+                    auto sig = std::make_shared<Signal>(bs, numCh);
+                    auto rev = std::make_shared<FdnReverb<float>>();
+
+                    FdnReverbBase::Parameters p;
+                    p.order = 16;
+                    p.decorrelate = decorrelate;
+                    rev->setParameters(p);
+                    rev->prepare(specFor(sr, bs, numCh));
+
+                    return [sig, rev]
+                    {
+                        sig->refresh();
+                        auto block = sig->out();
+                        rev->process(juce::dsp::ProcessContextReplacing<float>(block));
+                    };
+                }, numCh);
+            }
+
+            benchEngine<float>(suite, 2, AirBloomEngineBase::defaultChunkSize, "engine_bed", "4x_" + bed, numCh);
+        }
+    }
+
+    //==========================================================================
+    // Host state save / restore: the XML that get/setStateInformation used
+    // to write (PARAM id / value elements, as AudioProcessorValueTreeState
+    // makes them, behind copyXmlToBinary's header) against StateCodec.
+    // The XML side skips the ValueTree <-> XML conversion the plug-in also
+    // paid for, so it comes out a little flattering.
+    void benchState(Suite& suite)
+    {
+        // the plug-in's parameters, in its order
+        const juce::StringArray ids{ "bloom", "reverbWet", "inputGain", "outputGain", "bypass", "lowCut",
+                                     "oversample", "osFilter", "reverbDecay", "reverbSize", "reverbDamping",
+                                     "reverbOrder", "bloomMode", "bloomSide" };
+
+        const int num = ids.size();
+        auto values = std::make_shared<std::vector<float>>();
+        for (int i = 0; i < num; ++i)
+            values->push_back(0.1f + 0.37f * (float)i);
+
+        // ── XML ──
+        auto writeXml = [ids, values](juce::MemoryBlock& dest)
+        {
+            juce::XmlElement xml("PARAMETERS");
+            for (int i = 0; i < ids.size(); ++i)
+            {
+                auto* p = xml.createNewChildElement("PARAM");
+                p->setAttribute("id", ids[i]);
+                p->setAttribute("value", (*values)[(size_t)i]);
+            }
+
+            // copyXmlToBinary(): magic, length, then the text
+            juce::MemoryOutputStream out(dest, false);
+            out.writeInt(0x21324356);
+            out.writeInt(0);
+            xml.writeTo(out, juce::XmlElement::TextFormat().singleLine());
+            out.writeByte(0);
+        };
+
+        auto xmlState = std::make_shared<juce::MemoryBlock>();
+        writeXml(*xmlState);
+
+        suite.runCalls("state_save", "xml", [writeXml, block = std::make_shared<juce::MemoryBlock>()]
+        {
+            block->reset();
+            writeXml(*block);
+        }, xmlState->getSize());
+
+        suite.runCalls("state_restore", "xml", [ids, xmlState, out = std::make_shared<std::vector<float>>(num)]
+        {
+            auto text = juce::String::fromUTF8(static_cast<const char*>(xmlState->getData()) + 8);
+            if (auto xml = juce::XmlDocument::parse(text))
+                for (auto* p : xml->getChildWithTagNameIterator("PARAM"))
+                    if (const int i = ids.indexOf(p->getStringAttribute("id")); i >= 0)
+                        (*out)[(size_t)i] = (float)p->getDoubleAttribute("value");
+        }, xmlState->getSize());
+
+        // ── binary ──
+        auto codec = std::make_shared<StateCodec>(ids);
+        auto binState = std::make_shared<juce::MemoryBlock>();
+        codec->write(values->data(), *binState);
+
+        suite.runCalls("state_save", "binary", [codec, values, block = std::make_shared<juce::MemoryBlock>()]
+        {
+            codec->write(values->data(), *block);
+        }, binState->getSize());
+
+        suite.runCalls("state_restore", "binary", [codec, binState, out = std::make_shared<std::vector<float>>(num),
+                                                   found = std::make_shared<juce::HeapBlock<bool>>(num)]
+        {
+            codec->read(binState->getData(), binState->getSize(), out->data(), *found);
+        }, binState->getSize());
+    }
+
+    //==========================================================================
+    Settings parseArguments(int argc, char* argv[])
+    {
+        Settings s;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            const juce::String a(argv[i]);
+
+            if (a == "--json" && i + 1 < argc)
+                s.json = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+            else if (a == "--min-time" && i + 1 < argc)
+                s.minSeconds = juce::jmax(0.001, juce::String(argv[++i]).getDoubleValue());
+            else if (a == "--quick")
+                s.quick = true;
+            else
+                s.filter = a;
+        }
+
+        return s;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    const auto settings = parseArguments(argc, argv);
+
+    juce::ScopedNoDenormals noDenormals;
+    Suite suite(settings);
+
+    benchGainRamp(suite);
+    benchLowCut<float>(suite);
+    benchLowCut<double>(suite);
+    benchShelf<MultichannelBiquad<float>>(suite, {});
+    benchShelf<Biquad<>>(suite, "duplicator");
+    benchDrive(suite);
+    benchSoftClip<float>(suite);
+    benchSoftClip<double>(suite);
+    benchOversampling(suite);
+    benchReverb(suite);
+    benchMix(suite);
+    benchEngine(suite);
+    benchBeds(suite);
+    benchState(suite);
+
+    if (!suite.writeJson())
+    {
+        std::fprintf(stderr, "can't write %s\n", settings.json.getFullPathName().toRawUTF8());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,550 @@
+/*  AirBloomRender – run audio files through the AirBloom chain, headless.
+
+    No editor, no plug-in host, no display server: the same AirBloomEngine
+    the plug-in wraps, fed from a file in large blocks.
+
+        AirBloomRender [options] <input> <output>
+        AirBloomRender [options] --batch <folder | list.txt> <output folder>
+
+        --preset <file.abp>     load a preset saved by the plug-in
+        --param <id>=<value>    set one parameter (after the preset), e.g.
+                                --param bloom=0.6 --param oversample=3
+        --block <samples>       file I/O block size (default 16384)
+        --chunk <samples>       engine chunk size inside each block
+                                (default 512, see AirBloomEngine.h)
+        --bits <16|24|32>       output bit depth (default: same as input)
+        --realtime              cap oversampling at 4× as a live host would
+        --no-tail               stop at the input length instead of
+                                letting the reverb ring out
+        --profile               print p50 / p99 / max per engine stage
+                                (single renders of a build with
+                                AIRBLOOM_PROFILE_STAGES)
+        --jobs <n>              batch: files rendered at once (default:
+                                one per core)
+        --format <wav|aiff|flac>  batch: output type (default: as input)
+
+    Input and output can be WAV, AIFF or FLAC, from mono up to a
+    16-channel bed; the output format follows its file extension. The
+    colour path's latency is trimmed off, so the output lines up with the
+    input sample for sample.
+
+    Batch mode takes every audio file in a folder, or the paths listed in
+    a text file (one per line, relative to the list, # for comments).
+    Each worker owns one engine and pulls files off its own queue,
+    longest first, stealing from the others' when it runs dry. Decoding
+    and encoding run on per-worker I/O threads, so they overlap the DSP.
+    Every file goes through the same renderFile() as a single render,
+    from a freshly prepared engine, so the output is bit-identical.  */
+#include <juce_core/juce_core.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "AirBloomEngine.h"
+#include <deque>
+#include <thread>
+
+namespace
+{
+    struct Options
+    {
+        juce::File input, output;
+        AirBloomEngineBase::Parameters params;
+        int  blockSize = 16384;
+        int  chunkSize = AirBloomEngineBase::defaultChunkSize;
+        int  bitDepth = 0;              // 0 → same as input
+        bool realtime = false;
+        bool renderTail = true;
+        bool profile = false;
+
+        juce::File batchSource;         // folder or list; empty → single file
+        int  numJobs = 0;               // 0 → one per core
+        juce::String format;            // batch output extension, empty → as input
+    };
+
+    struct RenderJob
+    {
+        juce::File input, output;
+        juce::int64 cost = 0;           // samples × channels, for ordering
+    };
+
+    void printUsage()
+    {
+        std::printf("usage: AirBloomRender [--preset file.abp] [--param id=value ...]\n"
+                    "                      [--block n] [--chunk n] [--bits 16|24|32] [--realtime] [--no-tail] [--profile]\n"
+                    "                      <input> <output>\n"
+                    "       AirBloomRender [options] [--jobs n] [--format wav|aiff|flac]\n"
+                    "                      --batch <folder | list.txt> <output folder>\n");
+    }
+
+    /* .abp presets are the plug-in's parameter state as XML */
+    bool loadPreset(const juce::File& file, AirBloomEngineBase::Parameters& params)
+    {
+        auto xml = juce::XmlDocument::parse(file);
+
+        if (xml == nullptr)
+            return false;
+
+        for (auto* p : xml->getChildWithTagNameIterator("PARAM"))
+            params.set(p->getStringAttribute("id"), (float)p->getDoubleAttribute("value"));
+
+        return true;
+    }
+
+    juce::Result parseArguments(const juce::StringArray& args, Options& o)
+    {
+        juce::StringArray files;
+
+        for (int i = 0; i < args.size(); ++i)
+        {
+            const auto& a = args[i];
+            auto next = [&]() -> juce::String { return i + 1 < args.size() ? args[++i] : juce::String(); };
+
+            if (a == "--preset")
+            {
+                const juce::File f(juce::File::getCurrentWorkingDirectory().getChildFile(next()));
+                if (!loadPreset(f, o.params))
+                    return juce::Result::fail("can't read preset " + f.getFullPathName());
+            }
+            else if (a == "--param")
+            {
+                const auto kv = next();
+                if (!kv.containsChar('=')
+                    || !o.params.set(kv.upToFirstOccurrenceOf("=", false, false).trim(),
+                                     kv.fromFirstOccurrenceOf("=", false, false).getFloatValue()))
+                    return juce::Result::fail("unknown parameter " + kv.quoted());
+            }
+            else if (a == "--block")     o.blockSize = juce::jlimit(64, 1 << 20, next().getIntValue());
+            else if (a == "--chunk")     o.chunkSize = juce::jlimit(16, 1 << 16, next().getIntValue());
+            else if (a == "--bits")      o.bitDepth = next().getIntValue();
+            else if (a == "--realtime")  o.realtime = true;
+            else if (a == "--no-tail")   o.renderTail = false;
+            else if (a == "--profile")   o.profile = true;
+            else if (a == "--jobs")      o.numJobs = juce::jmax(1, next().getIntValue());
+            else if (a == "--format")    o.format = next().trimCharactersAtStart(".").toLowerCase();
+            else if (a == "--batch")
+                o.batchSource = juce::File::getCurrentWorkingDirectory().getChildFile(next());
+            else if (a.startsWith("--")) return juce::Result::fail("unknown option " + a);
+            else                         files.add(a);
+        }
+
+        const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+        if (o.batchSource != juce::File())
+        {
+            if (files.size() != 1)
+                return juce::Result::fail("batch mode needs one output folder");
+
+            if (o.profile)
+                return juce::Result::fail("--profile times a single render, not a batch");
+
+            o.output = cwd.getChildFile(files[0]);
+            return juce::Result::ok();
+        }
+
+        if (files.size() != 2)
+            return juce::Result::fail("need an input and an output file");
+
+        o.input = cwd.getChildFile(files[0]);
+        o.output = cwd.getChildFile(files[1]);
+        return juce::Result::ok();
+    }
+
+    //==========================================================================
+    struct RenderStats
+    {
+        double audioSeconds = 0.0;
+        int latency = 0;
+    };
+
+    /*  One file through a freshly prepared engine. The reader is buffered
+        ahead on readThread and the writer drains on writeThread; both
+        block rather than drop or pad, so the result never depends on
+        timing.                                                         */
+    juce::Result renderFile(AirBloomEngine<float>& engine, const RenderJob& job, const Options& o,
+                            juce::AudioFormatManager& formats,
+                            juce::TimeSliceThread& readThread, juce::TimeSliceThread& writeThread,
+                            RenderStats& stats)
+    {
+        std::unique_ptr<juce::AudioFormatReader> source(formats.createReaderFor(job.input));
+        if (source == nullptr)
+            return juce::Result::fail("can't read " + job.input.getFullPathName());
+
+        auto* format = formats.findFormatForFileExtension(job.output.getFileExtension());
+        if (format == nullptr)
+            return juce::Result::fail("unsupported output type " + job.output.getFileExtension());
+
+        const double sampleRate = source->sampleRate;
+        const int numCh = (int)source->numChannels;
+        const int bits = o.bitDepth > 0 ? o.bitDepth : (int)source->bitsPerSample;
+        const juce::int64 inputLength = source->lengthInSamples;
+
+        if (numCh > AirBloomEngineBase::maxChannels)
+            return juce::Result::fail(job.input.getFileName() + " has " + juce::String(numCh)
+                                      + " channels, the engine takes up to "
+                                      + juce::String(AirBloomEngineBase::maxChannels));
+
+        job.output.deleteFile();
+        std::unique_ptr<juce::OutputStream> stream(job.output.createOutputStream());
+        if (stream == nullptr)
+            return juce::Result::fail("can't write " + job.output.getFullPathName());
+
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            format->createWriterFor(stream.get(), sampleRate, (unsigned int)numCh, bits, {}, 0));
+        if (writer == nullptr)
+            return juce::Result::fail(format->getFormatName() + " can't write "
+                                      + juce::String(bits) + "-bit / " + juce::String(numCh) + " ch");
+        stream.release();   // the writer owns it now
+
+        // decode a few blocks ahead; a timeout of -1 makes read() wait
+        // for the data rather than hand back silence
+        juce::BufferingAudioReader reader(source.release(), readThread, 4 * o.blockSize);
+        reader.setReadTimeout(-1);
+
+        // ThreadedWriter flushes what's left when it's destroyed
+        auto threadedWriter = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(
+            writer.release(), writeThread, 4 * o.blockSize);
+
+        // offline, so 8× / 16× oversampling are allowed unless --realtime
+        engine.setChunkSize(o.chunkSize);
+        engine.prepare({ sampleRate, (juce::uint32)o.blockSize, (juce::uint32)numCh },
+                       o.params.getOversamplingMode(!o.realtime), o.params);
+        engine.setParameters(o.params);
+
+        const juce::int64 tail = o.renderTail
+            ? (juce::int64)std::ceil(AirBloomEngineBase::getTailSeconds(o.params) * sampleRate) : 0;
+
+        juce::int64 readPos = 0;
+        juce::int64 toSkip = engine.getLatencySamples();     // colour path latency
+        juce::int64 toWrite = inputLength + tail;
+
+        juce::AudioBuffer<float> buffer(numCh, o.blockSize);
+        juce::HeapBlock<const float*> chans((size_t)numCh);
+        juce::ScopedNoDenormals noDenormals;
+
+        while (toWrite > 0)
+        {
+            buffer.clear();
+
+            // past the end of the input the engine is fed silence
+            if (readPos < inputLength)
+            {
+                const int n = (int)juce::jmin((juce::int64)o.blockSize, inputLength - readPos);
+                reader.read(&buffer, 0, n, readPos, true, true);
+            }
+
+            readPos += o.blockSize;
+            engine.process(buffer);
+
+            const int skip = (int)juce::jmin(toSkip, (juce::int64)o.blockSize);
+            const int n = (int)juce::jmin(toWrite, (juce::int64)(o.blockSize - skip));
+            toSkip -= skip;
+
+            if (n > 0)
+            {
+                for (int ch = 0; ch < numCh; ++ch)
+                    chans[ch] = buffer.getReadPointer(ch, skip);
+
+                // FIFO full → the encoder is behind; wait for it
+                while (!threadedWriter->write(chans.get(), n))
+                    juce::Thread::sleep(1);
+            }
+
+            toWrite -= n;
+        }
+
+        threadedWriter.reset();     // flush + close
+        engine.release();
+
+        stats.audioSeconds = (double)(inputLength + tail) / sampleRate;
+        stats.latency = engine.getLatencySamples();
+        return juce::Result::ok();
+    }
+
+    /* a decode and an encode thread for one worker */
+    struct IoThreads
+    {
+        IoThreads()  { reading.startThread(); writing.startThread(); }
+        ~IoThreads() { reading.stopThread(2000); writing.stopThread(2000); }
+
+        juce::TimeSliceThread reading{ "AirBloom read" }, writing{ "AirBloom write" };
+    };
+
+    void printProfile(const StageProfiler& profiler)
+    {
+       #if AIRBLOOM_PROFILE_STAGES
+        std::printf("%-12s %10s %10s %10s %10s\n", "us / chunk", "p50", "p99", "max", "chunks");
+
+        for (int s = 0; s < StageProfiler::numStages; ++s)
+        {
+            const auto sum = profiler.getSummary(s);
+            std::printf("%-12s %10.1f %10.1f %10.1f %10llu\n", StageProfiler::getStageName(s),
+                        sum.p50, sum.p99, sum.max, (unsigned long long)sum.count);
+        }
+       #else
+        juce::ignoreUnused(profiler);
+        std::printf("--profile: built without AIRBLOOM_PROFILE_STAGES, nothing was timed\n");
+       #endif
+    }
+
+    juce::Result renderSingle(const Options& o)
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        IoThreads io;
+        AirBloomEngine<float> engine;
+        RenderStats stats;
+
+        StageProfiler profiler;
+        if (o.profile)
+            engine.setProfiler(&profiler);
+
+        const auto start = juce::Time::getMillisecondCounterHiRes();
+        const auto result = renderFile(engine, { o.input, o.output }, o, formats,
+                                       io.reading, io.writing, stats);
+        const double secs = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+
+        if (result.wasOk())
+            std::printf("%s → %s: %.1f s of audio in %.2f s (%.0f× realtime), latency %d\n",
+                        o.input.getFileName().toRawUTF8(), o.output.getFileName().toRawUTF8(),
+                        stats.audioSeconds, secs, secs > 0.0 ? stats.audioSeconds / secs : 0.0,
+                        stats.latency);
+
+        if (result.wasOk() && o.profile)
+            printProfile(profiler);
+
+        return result;
+    }
+
+    //==========================================================================
+    /*  One deque per worker. Jobs are dealt out longest first; a worker
+        takes from the front of its own deque and, once that's empty,
+        steals from the back of the busiest other one – so a few long
+        stems don't leave the other cores idle at the end.              */
+    class JobQueues
+    {
+    public:
+        JobQueues(std::vector<RenderJob> jobs, int numWorkers)
+        {
+            for (int i = 0; i < numWorkers; ++i)
+                lanes.push_back(std::make_unique<Lane>());
+
+            std::stable_sort(jobs.begin(), jobs.end(),
+                             [](const RenderJob& a, const RenderJob& b) { return a.cost > b.cost; });
+
+            for (size_t i = 0; i < jobs.size(); ++i)
+                lanes[i % lanes.size()]->jobs.push_back(std::move(jobs[i]));
+        }
+
+        bool next(int worker, RenderJob& job)
+        {
+            {
+                auto& own = *lanes[(size_t)worker];
+                const juce::ScopedLock sl(own.lock);
+
+                if (!own.jobs.empty())
+                {
+                    job = std::move(own.jobs.front());
+                    own.jobs.pop_front();
+                    return true;
+                }
+            }
+
+            // steal: pick the lane with the most work left
+            for (;;)
+            {
+                Lane* victim = nullptr;
+                juce::int64 most = 0;
+
+                for (auto& l : lanes)
+                {
+                    const juce::ScopedLock sl(l->lock);
+                    juce::int64 left = 0;
+                    for (auto& j : l->jobs)
+                        left += j.cost + 1;
+
+                    if (left > most)
+                    {
+                        most = left;
+                        victim = l.get();
+                    }
+                }
+
+                if (victim == nullptr)
+                    return false;
+
+                const juce::ScopedLock sl(victim->lock);
+                if (!victim->jobs.empty())          // may have emptied since
+                {
+                    job = std::move(victim->jobs.back());
+                    victim->jobs.pop_back();
+                    return true;
+                }
+            }
+        }
+
+    private:
+        struct Lane
+        {
+            juce::CriticalSection  lock;
+            std::deque<RenderJob>  jobs;
+        };
+
+        std::vector<std::unique_ptr<Lane>> lanes;
+    };
+
+    juce::Result collectBatch(const Options& o, juce::AudioFormatManager& formats,
+                              std::vector<RenderJob>& jobs)
+    {
+        juce::Array<juce::File> inputs;
+        const auto& src = o.batchSource;
+
+        if (src.isDirectory())
+        {
+            inputs = src.findChildFiles(juce::File::findFiles, false,
+                                        formats.getWildcardForAllFormats());
+            inputs.sort();
+        }
+        else if (src.existsAsFile())
+        {
+            juce::StringArray lines;
+            lines.addLines(src.loadFileAsString());
+
+            for (auto line : lines)
+            {
+                line = line.upToFirstOccurrenceOf("#", false, false).trim();
+                if (line.isNotEmpty())
+                    inputs.add(src.getParentDirectory().getChildFile(line));
+            }
+        }
+        else
+        {
+            return juce::Result::fail("no such folder or list: " + src.getFullPathName());
+        }
+
+        if (inputs.isEmpty())
+            return juce::Result::fail("nothing to render in " + src.getFullPathName());
+
+        if (!o.output.createDirectory())
+            return juce::Result::fail("can't create " + o.output.getFullPathName());
+
+        juce::StringArray outputNames;
+
+        for (auto& in : inputs)
+        {
+            std::unique_ptr<juce::AudioFormatReader> r(formats.createReaderFor(in));
+            if (r == nullptr)
+                return juce::Result::fail("can't read " + in.getFullPathName());
+
+            const auto ext = o.format.isNotEmpty() ? "." + o.format : in.getFileExtension();
+            const auto out = o.output.getChildFile(in.getFileNameWithoutExtension() + ext);
+
+            if (outputNames.contains(out.getFileName()))
+                return juce::Result::fail("two inputs would both write " + out.getFileName());
+
+            outputNames.add(out.getFileName());
+            jobs.push_back({ in, out, r->lengthInSamples * (juce::int64)r->numChannels });
+        }
+
+        return juce::Result::ok();
+    }
+
+    juce::Result renderBatch(const Options& o)
+    {
+        std::vector<RenderJob> jobs;
+        {
+            juce::AudioFormatManager formats;
+            formats.registerBasicFormats();
+
+            const auto r = collectBatch(o, formats, jobs);
+            if (r.failed())
+                return r;
+        }
+
+        const int numJobs = (int)jobs.size();
+        const int numWorkers = juce::jmin(numJobs, o.numJobs > 0 ? o.numJobs
+                                                                 : juce::SystemStats::getNumCpus());
+        JobQueues queues(std::move(jobs), numWorkers);
+
+        juce::CriticalSection printLock;
+        std::atomic<int> numFailed{ 0 };
+        double totalAudio = 0.0;
+
+        const auto start = juce::Time::getMillisecondCounterHiRes();
+
+        auto worker = [&](int index)
+        {
+            // each worker has its own engine, formats and I/O threads
+            juce::AudioFormatManager formats;
+            formats.registerBasicFormats();
+
+            IoThreads io;
+            AirBloomEngine<float> engine;
+            RenderJob job;
+
+            while (queues.next(index, job))
+            {
+                RenderStats stats;
+                const auto result = renderFile(engine, job, o, formats, io.reading, io.writing, stats);
+
+                const juce::ScopedLock sl(printLock);
+
+                if (result.wasOk())
+                {
+                    totalAudio += stats.audioSeconds;
+                    std::printf("[%d] %s → %s\n", index, job.input.getFileName().toRawUTF8(),
+                                job.output.getFileName().toRawUTF8());
+                }
+                else
+                {
+                    ++numFailed;
+                    job.output.deleteFile();
+                    std::fprintf(stderr, "[%d] %s: %s\n", index, job.input.getFileName().toRawUTF8(),
+                                 result.getErrorMessage().toRawUTF8());
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numWorkers; ++i)
+            threads.emplace_back(worker, i);
+
+        for (auto& t : threads)
+            t.join();
+
+        const double secs = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+        std::printf("%d files, %d workers: %.1f s of audio in %.2f s (%.0f× realtime)\n",
+                    numJobs, numWorkers, totalAudio, secs, secs > 0.0 ? totalAudio / secs : 0.0);
+
+        return numFailed > 0 ? juce::Result::fail(juce::String(numFailed.load()) + " of "
+                                                  + juce::String(numJobs) + " files failed")
+                             : juce::Result::ok();
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::String::fromUTF8(argv[i]));
+
+    if (args.isEmpty() || args.contains("--help") || args.contains("-h"))
+    {
+        printUsage();
+        return args.isEmpty() ? 1 : 0;
+    }
+
+    Options options;
+
+    auto result = parseArguments(args, options);
+    if (result.wasOk())
+        result = options.batchSource != juce::File() ? renderBatch(options)
+                                                     : renderSingle(options);
+
+    if (result.failed())
+    {
+        std::fprintf(stderr, "AirBloomRender: %s\n", result.getErrorMessage().toRawUTF8());
+        return 1;
+    }
+
+    return 0;
+}
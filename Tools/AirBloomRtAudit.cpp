@@ -0,0 +1,480 @@
+/*  AirBloomRtAudit – realtime-safety audit of the processing path.
+
+    Runs what processBlock() does – PresetMorph::process() feeding
+    AirBloomEngine::setParameters() / process(), with the MeterFeed
+    measuring and pushing levels and analysis audio around it – inside a
+    RealtimeGuard::ScopedSection, with malloc / calloc / realloc /
+    free / aligned allocation and pthread mutex / rwlock / condition waits
+    interposed for the whole process. On the audio thread, inside the
+    section, any of those is a violation. operator new / delete land in
+    malloc / free, so they're caught too.
+
+    The script per configuration (rate × max block × channels), run once
+    with the float engine and once with the double one:
+      - block sizes jump around between 1 sample and the prepared maximum,
+        and now and then overshoot it (up to 4×) as some hosts do
+      - every parameter is automated, Bloom and the gains on most blocks
+      - bypass, low cut, the reverb order and the mid / side Bloom mode
+        toggle now and then
+      - the input drops to silence and comes back (reverb sleep / wake)
+      - a second thread plays the message thread, switching the
+        oversampling factor and filter while audio runs, so path
+        hand-over, crossfade and retirement all happen mid-stream, and
+        posting random presets to the PresetMorph mailbox, so morphs
+        start, get overtaken by newer ones and finish mid-stream; it also
+        reads the meter and analysis FIFOs as the editor would, and turns
+        the analyser on and off
+
+    It also checks, outside any section, that bypass keeps time: toggling
+    it on and off at every realtime oversampling mode, an impulse train
+    has to come out exactly getLatencySamples() late whether the block
+    was processed or bypassed – the host compensates for that latency
+    either way.
+
+    Prints each violation (first few with a backtrace) and each
+    misaligned mode, and exits non-zero if there were any, so it can gate
+    a CI job:
+
+        AirBloomRtAudit              default: 20000 blocks per configuration
+        AirBloomRtAudit 200000       longer soak
+
+    Linux / glibc only – the interposers lean on glibc's __libc_malloc.  */
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "AirBloomEngine.h"
+#include "PresetMorph.h"
+#include "MeterFeed.h"
+#include "RealtimeGuard.h"
+
+#if defined(__GLIBC__)
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <cerrno>
+#include <thread>
+
+//==============================================================================
+// Interposers. These replace the libc symbols for the whole executable;
+// outside a ScopedSection notify() returns straight away.
+using Violation = RealtimeGuard::Violation;
+
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void  __libc_free(void*);
+
+    void* malloc(size_t n)
+    {
+        RealtimeGuard::notify(Violation::allocation, "malloc");
+        return __libc_malloc(n);
+    }
+
+    void* calloc(size_t n, size_t size)
+    {
+        RealtimeGuard::notify(Violation::allocation, "calloc");
+        return __libc_calloc(n, size);
+    }
+
+    void* realloc(void* p, size_t n)
+    {
+        RealtimeGuard::notify(Violation::allocation, "realloc");
+        return __libc_realloc(p, n);
+    }
+
+    void* memalign(size_t align, size_t n)
+    {
+        RealtimeGuard::notify(Violation::allocation, "memalign");
+        return __libc_memalign(align, n);
+    }
+
+    void* aligned_alloc(size_t align, size_t n)
+    {
+        RealtimeGuard::notify(Violation::allocation, "aligned_alloc");
+        return __libc_memalign(align, n);
+    }
+
+    int posix_memalign(void** out, size_t align, size_t n)
+    {
+        RealtimeGuard::notify(Violation::allocation, "posix_memalign");
+
+        if (auto* p = __libc_memalign(align, n))
+        {
+            *out = p;
+            return 0;
+        }
+
+        return ENOMEM;
+    }
+
+    void free(void* p)
+    {
+        if (p != nullptr)
+            RealtimeGuard::notify(Violation::deallocation, "free");
+
+        __libc_free(p);
+    }
+}
+
+namespace
+{
+    // looked up on first use; no function-local statics, their guards
+    // may lock
+    template <typename Fn>
+    Fn next(std::atomic<void*>& slot, const char* name) noexcept
+    {
+        auto* p = slot.load(std::memory_order_relaxed);
+
+        if (p == nullptr)
+        {
+            p = dlsym(RTLD_NEXT, name);
+            slot.store(p, std::memory_order_relaxed);
+        }
+
+        return reinterpret_cast<Fn>(p);
+    }
+
+    std::atomic<void*> realMutexLock{ nullptr }, realRdLock{ nullptr }, realWrLock{ nullptr },
+                       realCondWait{ nullptr }, realCondTimedWait{ nullptr };
+}
+
+extern "C"
+{
+    int pthread_mutex_lock(pthread_mutex_t* m)
+    {
+        RealtimeGuard::notify(Violation::lock, "pthread_mutex_lock");
+        return next<int (*)(pthread_mutex_t*)>(realMutexLock, "pthread_mutex_lock")(m);
+    }
+
+    int pthread_rwlock_rdlock(pthread_rwlock_t* l)
+    {
+        RealtimeGuard::notify(Violation::lock, "pthread_rwlock_rdlock");
+        return next<int (*)(pthread_rwlock_t*)>(realRdLock, "pthread_rwlock_rdlock")(l);
+    }
+
+    int pthread_rwlock_wrlock(pthread_rwlock_t* l)
+    {
+        RealtimeGuard::notify(Violation::lock, "pthread_rwlock_wrlock");
+        return next<int (*)(pthread_rwlock_t*)>(realWrLock, "pthread_rwlock_wrlock")(l);
+    }
+
+    int pthread_cond_wait(pthread_cond_t* c, pthread_mutex_t* m)
+    {
+        RealtimeGuard::notify(Violation::lock, "pthread_cond_wait");
+        return next<int (*)(pthread_cond_t*, pthread_mutex_t*)>(realCondWait, "pthread_cond_wait")(c, m);
+    }
+
+    int pthread_cond_timedwait(pthread_cond_t* c, pthread_mutex_t* m, const struct timespec* t)
+    {
+        RealtimeGuard::notify(Violation::lock, "pthread_cond_timedwait");
+        return next<int (*)(pthread_cond_t*, pthread_mutex_t*, const struct timespec*)>(
+            realCondTimedWait, "pthread_cond_timedwait")(c, m, t);
+    }
+}
+
+//==============================================================================
+namespace
+{
+    // Violations are recorded into fixed storage – the handler runs inside
+    // malloc, so it mustn't allocate itself.
+    struct Trap
+    {
+        Violation   kind;
+        const char* what;
+        void*       frames[32];
+        int         numFrames;
+    };
+
+    constexpr int maxTraps = 8;
+    Trap traps[maxTraps];
+    std::atomic<int> numViolations{ 0 };
+
+    void onViolation(Violation kind, const char* what)
+    {
+        const int i = numViolations++;
+
+        if (i < maxTraps)
+        {
+            traps[i].kind = kind;
+            traps[i].what = what;
+            traps[i].numFrames = backtrace(traps[i].frames, 32);
+        }
+    }
+
+    const char* kindName(Violation v)
+    {
+        switch (v)
+        {
+            case Violation::allocation:   return "allocation";
+            case Violation::deallocation: return "free";
+            case Violation::lock:         return "blocking call";
+        }
+
+        return "?";
+    }
+
+    //==========================================================================
+    struct Config
+    {
+        double sampleRate;
+        int    maxBlock;
+        int    numChannels;
+        int    numInputs = 0;      // 1 with two channels: mono in, stereo out
+    };
+
+    /* one prepared engine driven through the automation script */
+    template <typename SampleType>
+    int runConfig(const Config& cfg, int numBlocks)
+    {
+        AirBloomEngine<SampleType> engine;
+        PresetMorph morph;
+        MeterFeed meterFeed;
+        AirBloomEngineBase::Parameters p;
+        juce::Random rng(0xB100 + cfg.maxBlock);
+
+        const juce::dsp::ProcessSpec spec{ cfg.sampleRate, (juce::uint32)cfg.maxBlock,
+                                           (juce::uint32)cfg.numChannels };
+        engine.setNumInputChannels(cfg.numInputs);
+        engine.prepare(spec, p.getOversamplingMode(false), p);
+        morph.prepare(cfg.sampleRate);
+        meterFeed.prepare(cfg.sampleRate);
+        meterFeed.setConsumerActive(true);
+        meterFeed.setAnalysisWanted(true);
+        const int numInputs = cfg.numInputs > 0 ? cfg.numInputs : cfg.numChannels;
+
+        // room for blocks past the prepared maximum – the engine must
+        // chunk those, not grow its buffers
+        juce::AudioBuffer<SampleType> host(cfg.numChannels, 4 * cfg.maxBlock);
+        const int before = numViolations.load();
+
+        // the "message thread": oversampling switches and preset recalls
+        // while audio runs
+        std::atomic<bool> running{ true };
+        std::thread messageThread([&]
+        {
+            juce::Random r(42);
+            std::vector<MeterFeed::Frame> frames(64);
+            std::vector<float> analysis(MeterFeed::analysisFrameSize);
+
+            while (running)
+            {
+                // the editor's timer
+                meterFeed.popFrames(frames.data(), (int)frames.size());
+                while (meterFeed.popAnalysisFrame(analysis.data())) {}
+
+                if (r.nextInt(20) == 0)
+                    meterFeed.setAnalysisWanted(r.nextInt(4) != 0);
+
+                const OversamplingMode mode{ r.nextInt(OversamplingMode::numFactors),
+                                             (OversamplingMode::Filter)r.nextInt(OversamplingMode::numFilters) };
+                engine.updateColourPath(mode.resolvedFor(r.nextBool()));
+
+                if (r.nextBool())
+                {
+                    AirBloomEngineBase::Parameters preset;
+                    preset.bloom = r.nextFloat();
+                    preset.bloomMode = r.nextInt(2);
+                    preset.bloomSide = r.nextFloat();
+                    preset.reverbWet = r.nextFloat();
+                    preset.inputGainDb = (r.nextFloat() - 0.5f) * 48.0f;
+                    preset.outputGainDb = (r.nextFloat() - 0.5f) * 48.0f;
+                    preset.lowCut = r.nextBool();
+                    preset.reverbDecay = 0.3f + r.nextFloat() * 9.7f;
+                    preset.reverbSize = r.nextFloat();
+                    preset.reverbDamping = r.nextFloat();
+                    preset.reverbOrder = r.nextInt(3);
+
+                    // now and then a jump (0 s) rather than a glide
+                    morph.post(preset, r.nextInt(8) == 0 ? 0.0 : r.nextFloat() * 0.5);
+                }
+
+                juce::Thread::sleep(2 + r.nextInt(8));
+            }
+        });
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            // — host side, outside the section —
+            const int sizes[] = { 1, 2, 3, 16, 32, 64, 100, 128, 256, 441, 480 };
+            const int pick = rng.nextInt(10);
+            const int n = pick == 0 ? cfg.maxBlock + 1 + rng.nextInt(3 * cfg.maxBlock)   // oversized
+                        : pick < 3  ? cfg.maxBlock
+                                    : juce::jmin(cfg.maxBlock, sizes[rng.nextInt((int)std::size(sizes))]);
+
+            const bool silent = (b / 500) % 3 == 2;          // silent stretches
+            for (int ch = 0; ch < cfg.numChannels; ++ch)
+            {
+                auto* d = host.getWritePointer(ch);
+                for (int i = 0; i < n; ++i)
+                    d[i] = silent ? SampleType(0) : (SampleType)((rng.nextFloat() * 2.0f - 1.0f) * 0.5f);
+            }
+
+            p.bloom = juce::jlimit(0.0f, 1.0f, p.bloom + (rng.nextFloat() - 0.5f) * 0.1f);
+            p.inputGainDb = (rng.nextFloat() - 0.5f) * 48.0f;
+            p.outputGainDb = (rng.nextFloat() - 0.5f) * 48.0f;
+            p.reverbWet = rng.nextInt(10) == 0 ? 0.0f : rng.nextFloat();
+            p.reverbDecay = 0.3f + rng.nextFloat() * 9.7f;
+            p.reverbSize = rng.nextFloat();
+            p.reverbDamping = rng.nextFloat();
+            p.bloomSide = rng.nextFloat();
+
+            if (rng.nextInt(50) == 0)   p.lowCut = !p.lowCut;
+            if (rng.nextInt(100) == 0)  p.bypass = !p.bypass;
+            if (rng.nextInt(200) == 0)  p.reverbOrder = rng.nextInt(3);
+            if (rng.nextInt(100) == 0)  p.bloomMode = 1 - p.bloomMode;
+
+            juce::AudioBuffer<SampleType> block(host.getArrayOfWritePointers(), cfg.numChannels, n);
+
+            // — the processBlock() body —
+            {
+                const RealtimeGuard::ScopedSection rtSection;
+                juce::ScopedNoDenormals noDenormals;
+
+                MeterFeed::Frame frame;
+                frame.in = MeterFeed::measure(block, numInputs);
+
+                engine.setParameters(morph.process(p, n));
+                engine.process(block);
+
+                frame.clipReductionDb = engine.takeClipGainReductionDb();
+                frame.out = MeterFeed::measure(block, cfg.numChannels);
+                frame.numSamples = n;
+                meterFeed.push(frame);
+                meterFeed.pushAnalysis(block, cfg.numChannels);
+            }
+        }
+
+        running = false;
+        messageThread.join();
+        engine.release();
+
+        const int found = numViolations.load() - before;
+        std::printf("%-6s %6.0f Hz, max block %4d, %d%s ch: %d violation(s)\n",
+                    sizeof(SampleType) == sizeof(float) ? "float" : "double",
+                    cfg.sampleRate, cfg.maxBlock, cfg.numChannels,
+                    cfg.numInputs == 1 && cfg.numChannels == 2 ? " (from mono)" : "", found);
+        return found;
+    }
+}
+
+//==============================================================================
+namespace
+{
+    /* bypass on and off every dozen blocks – long enough for the 50 ms
+       bypass fade to finish – the impulses must all come out `latency`
+       samples late, processed, bypassed or in between (Bloom and reverb
+       off, so the processed signal is the delayed dry one) */
+    template <typename SampleType>
+    int checkBypassAlignment(OversamplingMode mode)
+    {
+        constexpr int blockSize = 256, numBlocks = 72, spacing = 97;
+
+        AirBloomEngine<SampleType> engine;
+        AirBloomEngineBase::Parameters p;
+        p.bloom = 0.0f;
+        p.reverbWet = 0.0f;
+
+        engine.prepare({ 48000.0, (juce::uint32)blockSize, 2 }, mode, p);
+        const int latency = engine.getLatencySamples();
+
+        juce::AudioBuffer<SampleType> block(2, blockSize);
+        int misaligned = 0;
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            block.clear();
+            for (int i = 0; i < blockSize; ++i)
+                if ((b * blockSize + i) % spacing == 0)
+                    for (int ch = 0; ch < 2; ++ch)
+                        block.setSample(ch, i, SampleType(0.5));
+
+            p.bypass = (b / 12) % 2 == 1;
+            engine.setParameters(p);
+            engine.process(block);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const int t = b * blockSize + i - latency;     // input time
+                const bool expected = t >= 0 && t % spacing == 0;
+                const auto level = std::abs(block.getSample(0, i));
+
+                if (expected ? level < SampleType(0.1) : level > SampleType(1.0e-4))
+                    ++misaligned;
+            }
+        }
+
+        std::printf("bypass alignment %-6s %2dx %-12s latency %3d: %s\n",
+                    sizeof(SampleType) == sizeof(float) ? "float" : "double",
+                    mode.getFactor(), OversamplingMode::getFilterNames()[(int)mode.filter].toRawUTF8(),
+                    latency, misaligned == 0 ? "ok" : "MISALIGNED");
+        return misaligned > 0 ? 1 : 0;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    const int numBlocks = argc > 1 ? juce::jmax(1, juce::String(argv[1]).getIntValue()) : 20000;
+
+    // backtrace() loads libgcc on first use – do that before anything
+    // is being watched
+    void* warm[1];
+    backtrace(warm, 1);
+
+    RealtimeGuard::setHandler(onViolation);
+
+    const Config configs[] = {
+        { 44100.0,  512, 2 },
+        { 48000.0, 1024, 1 },
+        { 96000.0,  256, 2 },
+        { 192000.0, 2048, 2 },
+        { 48000.0,  512, 12 },     // 7.1.4
+        { 44100.0,  512, 2, 1 },   // mono → stereo
+    };
+
+    int total = 0;
+    for (const auto& c : configs)
+        total += runConfig<float>(c, numBlocks) + runConfig<double>(c, numBlocks);
+
+    RealtimeGuard::setHandler(nullptr);
+
+    int misaligned = 0;
+    for (int f = 0; f <= OversamplingMode::maxRealtimeFactorChoice; ++f)
+        for (int filter = 0; filter < OversamplingMode::numFilters; ++filter)
+        {
+            const OversamplingMode mode{ f, (OversamplingMode::Filter)filter };
+            misaligned += checkBypassAlignment<float>(mode) + checkBypassAlignment<double>(mode);
+        }
+
+    for (int i = 0; i < juce::jmin(total, maxTraps); ++i)
+    {
+        std::fprintf(stderr, "\n#%d %s: %s\n", i + 1, kindName(traps[i].kind), traps[i].what);
+        std::fflush(stderr);
+        backtrace_symbols_fd(traps[i].frames, traps[i].numFrames, 2);
+    }
+
+    if (total > 0)
+        std::printf("\nFAILED: %d realtime violation(s) on the processing path\n", total);
+
+    if (misaligned > 0)
+        std::printf("\nFAILED: bypass is out of time with the reported latency in %d mode(s)\n", misaligned);
+
+    if (total > 0 || misaligned > 0)
+        return 1;
+
+    std::printf("\nOK: no allocations, frees or blocking calls on the processing path, bypass in time\n");
+    return 0;
+}
+
+#else
+
+int main()
+{
+    std::printf("AirBloomRtAudit needs glibc (Linux); nothing to do here\n");
+    return 0;
+}
+
+#endif
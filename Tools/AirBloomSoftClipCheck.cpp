@@ -0,0 +1,129 @@
+/*  AirBloomSoftClipCheck – accuracy check of the Bloom soft clip.
+
+    Sweeps x across the whole range the clip sees (past the clamp on both
+    sides, so the flat tails are covered too) and runs it through
+    SoftClipper::processSamples() – the vector kernel this build uses,
+    with a tail that isn't a whole number of lanes so the scalar path runs
+    as well – in float and in double. Every output is compared against
+    std::tanh(drive · x) worked out in double:
+
+        |processSamples(x) − tanh(drive · x)| ≤ SoftClipper::maxAbsError
+
+    and, where the clip spends most of its time (|drive · x| below
+    SoftClipper::innerRange), ≤ SoftClipper::maxInnerError.
+
+    Also checks the curve stays odd and never steps backwards by more
+    than rounding (a few ulps – float arithmetic in the rational isn't
+    exactly monotonic, and that's far below anything audible). Prints the
+    worst error per precision and exits non-zero if any sample is out of
+    bounds, so it can gate a CI job:
+
+        AirBloomSoftClipCheck                                           */
+#include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
+#include "SoftClipKernel.h"
+#include <limits>
+
+namespace
+{
+    const char* kernelName()
+    {
+       #if ! AIRBLOOM_SOFTCLIP_SIMD
+        return "std::tanh reference";
+       #elif AIRBLOOM_SOFTCLIP_AVX
+        return "AVX";
+       #elif AIRBLOOM_SOFTCLIP_SSE
+        return "SSE2";
+       #elif AIRBLOOM_SOFTCLIP_NEON
+        return "NEON";
+       #else
+        return "scalar";
+       #endif
+    }
+
+    constexpr int numSteps = 400003;                        // odd: not a multiple of any lane count
+
+    /* the sweep: ±range in equal steps, then a few far-out values */
+    template <typename SampleType>
+    std::vector<SampleType> makeInputs()
+    {
+        const double range = 1.5 * (double)SoftClipper::clampX / (double)SoftClipper::drive;
+
+        std::vector<SampleType> x;
+        x.reserve((size_t)numSteps + 8);
+
+        for (int i = 0; i < numSteps; ++i)
+            x.push_back((SampleType)(-range + 2.0 * range * i / (numSteps - 1)));
+
+        for (const double far : { 10.0, 100.0, 1.0e6 })
+        {
+            x.push_back((SampleType)far);
+            x.push_back((SampleType)-far);
+        }
+
+        return x;
+    }
+
+    template <typename SampleType>
+    int check(const char* name)
+    {
+        const auto in = makeInputs<SampleType>();
+        auto out = in;
+        SoftClipper::processSamples(out.data(), out.size());
+
+        const auto slack = 4 * std::numeric_limits<SampleType>::epsilon();
+        double worst = 0.0, worstAt = 0.0;
+        int outOfBounds = 0, notOdd = 0, backwards = 0;
+
+        for (size_t i = 0; i < in.size(); ++i)
+        {
+            const double err = std::abs((double)out[i] - std::tanh((double)SoftClipper::drive * (double)in[i]));
+
+            if (err > worst)
+            {
+                worst = err;
+                worstAt = (double)in[i];
+            }
+
+            const bool inner = std::abs((double)SoftClipper::drive * (double)in[i]) < (double)SoftClipper::innerRange;
+            const auto bound = inner ? SoftClipper::maxInnerError : SoftClipper::maxAbsError;
+
+            if (!(err <= (double)bound))                         // NaN fails too
+                ++outOfBounds;
+
+            SampleType neg = -in[i];
+            SoftClipper::processSamples(&neg, 1);
+            if (neg != -out[i])
+                ++notOdd;
+
+            if (i > 0 && i < (size_t)numSteps && out[i] < out[i - 1] - slack)
+                ++backwards;
+        }
+
+        std::printf("%-6s %zu samples: worst |error| %.3g at x = %.4f (bound %.1g)\n",
+                    name, in.size(), worst, worstAt, (double)SoftClipper::maxAbsError);
+
+        if (outOfBounds > 0)  std::printf("       %d sample(s) outside the bound\n", outOfBounds);
+        if (notOdd > 0)       std::printf("       %d sample(s) where f(-x) != -f(x)\n", notOdd);
+        if (backwards > 0)    std::printf("       %d step(s) where the curve goes backwards\n", backwards);
+
+        return outOfBounds + notOdd + backwards;
+    }
+}
+
+//==============================================================================
+int main()
+{
+    std::printf("soft clip kernel: %s\n", kernelName());
+
+    const int failures = check<float>("float") + check<double>("double");
+
+    if (failures > 0)
+    {
+        std::printf("\nFAILED: the soft clip is outside its error bound against std::tanh\n");
+        return 1;
+    }
+
+    std::printf("\nOK: within %.1g of std::tanh everywhere\n", (double)SoftClipper::maxAbsError);
+    return 0;
+}